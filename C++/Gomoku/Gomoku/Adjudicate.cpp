@@ -0,0 +1,161 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Adjudicator.h"
+namespace Gomoku
+{
+    class Adjudicate
+    {
+    private:
+        static constexpr const std::size_t ChunkSize = 1u << 16;
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            unsigned Threads = 0u;
+            bool Quiet = false;
+            bool Lines = false;
+            bool Verify = false;
+            bool Memoise = false;
+            const char* Path = nullptr;
+            const char* Trace = nullptr;
+            std::uint64_t Threshold = 0u;
+            for (int i = 1; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { Threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+                else if (std::strcmp(argv[i], "--quiet") == 0) { Quiet = true; }
+                else if (std::strcmp(argv[i], "--lines") == 0) { Lines = true; }
+                else if (std::strcmp(argv[i], "--verify") == 0) { Verify = true; }
+                else if (std::strcmp(argv[i], "--memo") == 0) { Memoise = true; }
+                else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) { Trace = argv[++i]; }
+                else if (std::strcmp(argv[i], "--trace-min") == 0 && i + 1 < argc) { Threshold = std::strtoull(argv[++i], nullptr, 10); }
+                else if (argv[i][0] != '-' && Path == nullptr) { Path = argv[i]; }
+                else
+                {
+                    std::fprintf(stderr, "usage: %s [--threads N] [--quiet] [--lines] [--verify] [--memo] [--trace file] [--trace-min N] [records.txt]\n", argv[0]);
+                    return 1;
+                }
+            }
+            std::ifstream File{};
+            if (Path != nullptr)
+            {
+                File.open(Path);
+                if (!File)
+                {
+                    std::fprintf(stderr, "cannot open %s\n", Path);
+                    return 1;
+                }
+            }
+            std::istream& In = Path != nullptr ? File : std::cin;
+            if (Trace != nullptr && (!Instrument::Enabled || !Instrument::Trace(Trace, Threshold)))
+            {
+                std::fprintf(stderr, Instrument::Enabled ? "cannot open %s\n" : "tracing %s needs a build with GOMOKU_INSTRUMENT\n", Trace);
+                return 1;
+            }
+            Scheduler Sc{ Threads };
+            std::vector<std::string> Records{};
+            std::vector<Adjudicator::Report> Reports{};
+            std::uint64_t Games = 0u;
+            std::uint64_t Moves = 0u;
+            std::uint64_t Forbids = 0u;
+            std::uint64_t Probes = 0u;
+            std::uint64_t Hits = 0u;
+            std::uint32_t Deepest = 0u;
+            std::atomic<std::uint64_t> Mismatches{ 0u };
+            std::vector<std::vector<Position>> Parsed(Sc.Threads());
+            std::chrono::steady_clock::duration Spent{};
+            std::string Line{};
+            while (In)
+            {
+                Records.clear();
+                while (Records.size() < ChunkSize && std::getline(In, Line)) { Records.push_back(Line); }
+                if (Records.empty()) { break; }
+                std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+                if (Lines) { Adjudicator::Adjudicate<LineBoard>(Sc, Records, Reports, Memoise); }
+                else { Adjudicator::Adjudicate<Board>(Sc, Records, Reports, Memoise); }
+                Spent += std::chrono::steady_clock::now() - Begin;
+                if (Verify)
+                {
+                    Sc.ParallelFor(Records.size(), 64u, [&](std::size_t i, unsigned Worker)
+                    {
+                        Notation::ParseGame(Records[i], Parsed[Worker]);
+                        int Count = Adjudicator::Verify(Parsed[Worker].data(), static_cast<int>(Parsed[Worker].size()));
+                        if (Count > 0) { Mismatches.fetch_add(static_cast<std::uint64_t>(Count), std::memory_order_relaxed); }
+                    });
+                }
+                for (std::size_t i = 0; i < Reports.size(); ++i)
+                {
+                    const Adjudicator::Report& Rp = Reports[i];
+                    Moves += static_cast<std::uint64_t>(Rp.Played);
+                    if (Rp.Fo != Forbidden::None) { ++Forbids; }
+                    Probes += Rp.Probes;
+                    Hits += Rp.Hits;
+                    Deepest = std::max(Deepest, Rp.Depth);
+                    if (Quiet) { continue; }
+                    if (Rp.Faulty >= 0) { std::printf("%llu\tIllegal\tNone\t%d\t%d\n", static_cast<unsigned long long>(Games + i), Rp.Faulty + 1, Rp.Played); }
+                    else { std::printf("%llu\t%s\t%s\t%d\t%d\n", static_cast<unsigned long long>(Games + i), Notation::Name(Rp.Re), Notation::Name(Rp.Fo), Rp.Decisive + 1, Rp.Played); }
+                }
+                Games += Records.size();
+            }
+            double Seconds = std::chrono::duration<double>(Spent).count();
+            if (Seconds <= 0) { Seconds = 1e-9; }
+            std::fprintf(stderr, "threads %u, games %llu, moves %llu, forbidden %llu, %.3f s, %.0f games/s, %.0f moves/s\n",
+                Sc.Threads(), static_cast<unsigned long long>(Games), static_cast<unsigned long long>(Moves), static_cast<unsigned long long>(Forbids),
+                Seconds, Games / Seconds, Moves / Seconds);
+            if (Memoise)
+            {
+                std::fprintf(stderr, "s3 probes %llu, memo hits %.1f%%, deepest recursion %u\n",
+                    static_cast<unsigned long long>(Probes), Probes > 0u ? Hits * 100e0 / Probes : 0e0, Deepest);
+            }
+            if constexpr (Instrument::Enabled)
+            {
+                Instrument::Finish();
+                Instrument::Print(stderr);
+            }
+            if (Verify)
+            {
+                std::fprintf(stderr, "bitboard mismatches %llu\n", static_cast<unsigned long long>(Mismatches.load()));
+                if (Mismatches.load() != 0u) { return 2; }
+            }
+            return 0;
+        };
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Adjudicate::Main(argc, argv);
+};
@@ -0,0 +1,140 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <string>
+#include <vector>
+#include "Bitboard.h"
+#include "Notation.h"
+#include "Referee.h"
+#include "Scheduler.h"
+namespace Gomoku
+{
+    class Adjudicator
+    {
+#pragma region helper-classes
+    public:
+        struct Report
+        {
+        public:
+            Result Re;
+            Forbidden Fo;
+            int Played;
+            int Decisive;
+            int Faulty;
+            std::uint32_t Probes;
+            std::uint32_t Hits;
+            std::uint32_t Depth;
+            constexpr Report()
+                : Re{ Result::None }, Fo{ Forbidden::None }, Played{ 0 }, Decisive{ -1 }, Faulty{ -1 }, Probes{ 0u }, Hits{ 0u }, Depth{ 0u }
+            {};
+        };
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        template <typename B = Board>
+        static constexpr Report Adjudicate(const Position* Moves, int Count, Memo* Me = nullptr)
+        {
+            Report Rp{};
+            B Bo{};
+            BasicReferee<B> Rf{ Bo, Me };
+            std::uint64_t Hits = 0u;
+            std::uint64_t Misses = 0u;
+            if (Me != nullptr)
+            {
+                Hits = Me->Hits;
+                Misses = Me->Misses;
+                Me->Deepest = 0u;
+            }
+            for (int i = 0; i < Count; ++i)
+            {
+                if (!Bo.CanPutChess(Moves[i]))
+                {
+                    Rp.Faulty = i;
+                    break;
+                }
+                Verdict Ve = Rf.PutChess(Moves[i]);
+                ++Rp.Played;
+                if (Ve.Re != Result::None)
+                {
+                    Rp.Re = Ve.Re;
+                    Rp.Fo = Ve.Fo;
+                    Rp.Decisive = i;
+                    break;
+                }
+            }
+            if (Me != nullptr)
+            {
+                Rp.Hits = static_cast<std::uint32_t>(Me->Hits - Hits);
+                Rp.Probes = Rp.Hits + static_cast<std::uint32_t>(Me->Misses - Misses);
+                Rp.Depth = Me->Deepest;
+            }
+            return Rp;
+        };
+        static int Verify(const Position* Moves, int Count)
+        {
+            int Mismatches = 0;
+            Board Bo{};
+            Bitboard Bb{};
+            Referee Rf{ Bo };
+            for (int i = 0; i < Count && Bo.CanPutChess(Moves[i]); ++i)
+            {
+                bool Bk = Bo.IsBlackTurn();
+                Verdict Ve = Rf.PutChess(Moves[i]);
+                Bb.Put(Moves[i], Bk ? Chess::Black : Chess::White);
+                if (Bk)
+                {
+                    if (Bb.Overlines(Chess::Black).Any() != (Ve.Fo == Forbidden::Overline)) { ++Mismatches; }
+                    if (Ve.Fo == Forbidden::None && Bb.ExactFives(Chess::Black).Any() != (Ve.Re == Result::Won)) { ++Mismatches; }
+                    if (Ve.Fo == Forbidden::FourFour && Bitboard::Count(Bb.FivePoints(Chess::Black, false)) < 2) { ++Mismatches; }
+                }
+                else if (Bb.Fives(Chess::White).Any() != (Ve.Re == Result::Lost)) { ++Mismatches; }
+                if (Ve.Re != Result::None) { break; }
+            }
+            return Mismatches;
+        };
+        template <typename B = Board>
+        static void Adjudicate(Scheduler& Sc, const std::vector<std::string>& Records, std::vector<Report>& Reports, bool Memoise = false)
+        {
+            Reports.assign(Records.size(), Report{});
+            std::vector<std::vector<Position>> Moves(Sc.Threads());
+            std::vector<Memo> Memos(Memoise ? Sc.Threads() : 0u);
+            Sc.ParallelFor(Records.size(), 64u, [&](std::size_t i, unsigned Worker)
+            {
+                std::vector<Position>& Mv = Moves[Worker];
+                if (!Notation::ParseGame(Records[i], Mv))
+                {
+                    Reports[i].Faulty = static_cast<int>(Mv.size());
+                    return;
+                }
+                Reports[i] = Adjudicate<B>(Mv.data(), static_cast<int>(Mv.size()), Memoise ? &Memos[Worker] : nullptr);
+            });
+        };
+#pragma endregion
+    };
+}
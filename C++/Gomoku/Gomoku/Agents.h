@@ -0,0 +1,179 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include "Engine.h"
+#include "Mcts.h"
+#include "Referee.h"
+#include "TranspositionTable.h"
+namespace Gomoku
+{
+    class Agent
+    {
+    public:
+        virtual ~Agent() = default;
+        virtual const char* Name() const & = 0;
+        // Returns a Position where the Board accepts a Chess of the side to move, or Position::Null to resign.
+        virtual Position Move(const Board& Bo) & = 0;
+        static std::unique_ptr<Agent> Make(const std::string& Spec, std::uint64_t Seed);
+    protected:
+        static bool Playable(Board& Bo, Position Po)
+        {
+            if (!Bo.CanPutChess(Po)) { return false; }
+            if (!Bo.IsBlackTurn()) { return true; }
+            Referee Rf{ Bo };
+            return Rf.Forbid(Po) == Forbidden::None;
+        };
+    };
+    class RandomAgent : public Agent
+    {
+    private:
+        std::mt19937_64 Rng;
+    public:
+        explicit RandomAgent(std::uint64_t Seed)
+            : Rng{ Seed }
+        {};
+        const char* Name() const & override
+        {
+            return "random";
+        };
+        Position Move(const Board& Bo) & override
+        {
+            Board Copy = Bo;
+            std::uint8_t Moves[225]{};
+            int Count = 0;
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                for (int X = 0; X < 15; ++X)
+                {
+                    if (Copy.CanPutChess(Position{ X, Y })) { Moves[Count++] = static_cast<std::uint8_t>(Position{ X, Y }); }
+                }
+            }
+            while (Count > 0)
+            {
+                int i = static_cast<int>(Rng() % static_cast<std::uint64_t>(Count));
+                if (Playable(Copy, Position{ Moves[i] })) { return Position{ Moves[i] }; }
+                Moves[i] = Moves[--Count];
+            }
+            return Position::Null;
+        };
+    };
+    class GreedyAgent : public Agent
+    {
+    private:
+        std::mt19937_64 Rng;
+    public:
+        explicit GreedyAgent(std::uint64_t Seed)
+            : Rng{ Seed }
+        {};
+        const char* Name() const & override
+        {
+            return "greedy";
+        };
+        // Takes the best move by the MoveGenerator ordering, breaking ties at random.
+        Position Move(const Board& Bo) & override
+        {
+            Board Copy = Bo;
+            Engine::Candidates Moves{};
+            int Count = Engine::Generate(Copy, Moves);
+            Position Best = Position::Null;
+            std::uint64_t Ties = 0u;
+            for (int i = 0; i < Count; ++i)
+            {
+                if (Best != Position::Null && Moves[0] > Moves[i]) { break; }
+                if (!Playable(Copy, Moves[i].Po)) { continue; }
+                if (Rng() % ++Ties == 0u) { Best = Moves[i].Po; }
+            }
+            return Best;
+        };
+    };
+    class EngineAgent : public Agent
+    {
+    private:
+        std::unique_ptr<TranspositionTable> Tt;
+        Engine En;
+        std::chrono::milliseconds Budget;
+        std::string Label;
+    public:
+        explicit EngineAgent(std::chrono::milliseconds Budget, std::size_t Megabytes)
+            : Tt{ Megabytes > 0u ? std::make_unique<TranspositionTable>(Megabytes) : nullptr }, En{ Tt.get() }, Budget{ Budget },
+            Label{ "engine:" + std::to_string(Budget.count()) }
+        {};
+        const char* Name() const & override
+        {
+            return Label.c_str();
+        };
+        Position Move(const Board& Bo) & override
+        {
+            return En.BestMove(Bo, Budget);
+        };
+    };
+    class MctsAgent : public Agent
+    {
+    private:
+        Mcts Mc;
+        std::chrono::milliseconds Budget;
+        std::string Label;
+    public:
+        explicit MctsAgent(std::chrono::milliseconds Budget, std::size_t Megabytes, std::uint64_t Seed)
+            : Mc{ 1u, Megabytes, Seed }, Budget{ Budget }, Label{ "mcts:" + std::to_string(Budget.count()) }
+        {};
+        const char* Name() const & override
+        {
+            return Label.c_str();
+        };
+        Position Move(const Board& Bo) & override
+        {
+            return Mc.BestMove(Bo, Budget);
+        };
+    };
+    // Spec is random, greedy, engine:MS for an Engine or mcts:MS for a single thread of Mcts, searching MS
+    // milliseconds per move.
+    inline std::unique_ptr<Agent> Agent::Make(const std::string& Spec, std::uint64_t Seed)
+    {
+        if (Spec == "random") { return std::make_unique<RandomAgent>(Seed); }
+        if (Spec == "greedy") { return std::make_unique<GreedyAgent>(Seed); }
+        if (Spec.rfind("engine:", 0) == 0)
+        {
+            long Ms = std::strtol(Spec.c_str() + 7, nullptr, 10);
+            if (Ms > 0) { return std::make_unique<EngineAgent>(std::chrono::milliseconds{ Ms }, 16u); }
+        }
+        if (Spec.rfind("mcts:", 0) == 0)
+        {
+            long Ms = std::strtol(Spec.c_str() + 5, nullptr, 10);
+            if (Ms > 0) { return std::make_unique<MctsAgent>(std::chrono::milliseconds{ Ms }, 16u, Seed); }
+        }
+        return nullptr;
+    };
+}
@@ -0,0 +1,165 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Adjudicator.h"
+#include "Archive.h"
+namespace Gomoku
+{
+    class Records
+    {
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            if (argc >= 3 && std::strcmp(argv[1], "pack") == 0) { return Pack(argc == 4 ? argv[2] : nullptr, argv[argc - 1]); }
+            if (argc == 3 && std::strcmp(argv[1], "unpack") == 0) { return Unpack(argv[2]); }
+            if (argc == 3 && std::strcmp(argv[1], "bench") == 0) { return Bench(argv[2]); }
+            std::fprintf(stderr, "usage: %s pack [records.txt] archive | unpack archive | bench archive\n", argv[0]);
+            return 1;
+        };
+    private:
+        // Converts a game of moves in the Notation on each line into the archive, judged by the Adjudicator,
+        // where a record which cannot be parsed or replayed is left out.
+        static int Pack(const char* Source, const char* Target)
+        {
+            std::ifstream File{};
+            if (Source != nullptr)
+            {
+                File.open(Source);
+                if (!File)
+                {
+                    std::fprintf(stderr, "cannot open %s\n", Source);
+                    return 1;
+                }
+            }
+            std::istream& In = Source != nullptr ? File : std::cin;
+            Archive::Writer Wr{ Target };
+            if (!Wr)
+            {
+                std::fprintf(stderr, "cannot create %s\n", Target);
+                return 1;
+            }
+            std::uint64_t Games = 0u;
+            std::uint64_t Skipped = 0u;
+            std::vector<Position> Moves{};
+            std::string Line{};
+            while (std::getline(In, Line))
+            {
+                Adjudicator::Report Rp{};
+                if (Notation::ParseGame(Line, Moves) && Moves.size() <= 225u)
+                {
+                    Rp = Adjudicator::Adjudicate<Board>(Moves.data(), static_cast<int>(Moves.size()));
+                }
+                if (Moves.empty() || Moves.size() > 225u || Rp.Faulty >= 0)
+                {
+                    ++Skipped;
+                    continue;
+                }
+                if (Wr.Write(Moves.data(), static_cast<int>(Moves.size()), Rp.Re, Rp.Fo)) { ++Games; }
+                else { ++Skipped; }
+            }
+            if (!Wr)
+            {
+                std::fprintf(stderr, "cannot write %s\n", Target);
+                return 1;
+            }
+            std::fprintf(stderr, "games %llu, skipped %llu\n", static_cast<unsigned long long>(Games), static_cast<unsigned long long>(Skipped));
+            return 0;
+        };
+        static int Unpack(const char* Source)
+        {
+            Archive Ar{ Source };
+            if (!Ar.Valid())
+            {
+                std::fprintf(stderr, "%s is not an archive\n", Source);
+                return 1;
+            }
+            std::string Line{};
+            for (Archive::Game Ga : Ar)
+            {
+                Line.clear();
+                for (int i = 0; i < Ga.Count; ++i)
+                {
+                    if (i > 0) { Line += ' '; }
+                    Line += Notation::Format(Ga[i]);
+                }
+                std::printf("%s\n", Line.c_str());
+            }
+            return 0;
+        };
+        // Walks the archive in place, and then replays every game through the Adjudicator, in games per second.
+        static int Bench(const char* Source)
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            Archive Ar{ Source };
+            if (!Ar.Valid())
+            {
+                std::fprintf(stderr, "%s is not an archive\n", Source);
+                return 1;
+            }
+            std::uint64_t Games = 0u;
+            std::uint64_t Moves = 0u;
+            std::uint64_t Sum = 0u;
+            for (Archive::Game Ga : Ar)
+            {
+                ++Games;
+                Moves += static_cast<std::uint64_t>(Ga.Count);
+                for (int i = 0; i < Ga.Count; ++i) { Sum += Ga.Moves[i]; }
+            }
+            double Walk = std::chrono::duration<double>(std::chrono::steady_clock::now() - Begin).count();
+            Begin = std::chrono::steady_clock::now();
+            std::uint64_t Mismatches = 0u;
+            std::vector<Position> Buffer(225u, Position::Null);
+            for (Archive::Game Ga : Ar)
+            {
+                for (int i = 0; i < Ga.Count; ++i) { Buffer[i] = Ga[i]; }
+                Adjudicator::Report Rp = Adjudicator::Adjudicate<Board>(Buffer.data(), Ga.Count);
+                if (Rp.Re != Ga.Re || Rp.Fo != Ga.Fo) { ++Mismatches; }
+            }
+            double Replay = std::chrono::duration<double>(std::chrono::steady_clock::now() - Begin).count();
+            Walk = Walk > 0 ? Walk : 1e-9;
+            Replay = Replay > 0 ? Replay : 1e-9;
+            std::fprintf(stderr, "games %llu, moves %llu, %.1f MB, checksum %llx\n", static_cast<unsigned long long>(Games),
+                static_cast<unsigned long long>(Moves), Ar.Bytes() / 1e6, static_cast<unsigned long long>(Sum));
+            std::fprintf(stderr, "walk %.3f s, %.0f games/s, %.0f MB/s\n", Walk, Games / Walk, Ar.Bytes() / 1e6 / Walk);
+            std::fprintf(stderr, "adjudicate %.3f s, %.0f games/s, mismatches %llu\n", Replay, Games / Replay, static_cast<unsigned long long>(Mismatches));
+            return Mismatches != 0u ? 2 : 0;
+        };
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Records::Main(argc, argv);
+};
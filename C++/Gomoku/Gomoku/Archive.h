@@ -0,0 +1,166 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "MappedFile.h"
+#include "Referee.h"
+namespace Gomoku
+{
+    // An archive is the 8 bytes of Magic followed by its games, each of which is a byte of the Result in bits
+    // 0 to 1 and the Forbidden in bits 2 to 3, a byte of the number of moves, and a byte of each move as the
+    // Position. The Archive maps a file and walks its games in place.
+    class Archive
+    {
+#pragma region constants
+    public:
+        static constexpr const char Magic[8]{ 'G', 'o', 'm', 'o', 'k', 'u', '\x01', '\0' };
+#pragma endregion
+#pragma region helper-classes
+    public:
+        struct Game
+        {
+        public:
+            Result Re;
+            Forbidden Fo;
+            int Count;
+            const std::uint8_t* Moves;
+            constexpr Game()
+                : Re{ Result::None }, Fo{ Forbidden::None }, Count{ 0 }, Moves{ nullptr }
+            {};
+            constexpr Position operator[](int i) const &
+            {
+                return Position{ Moves[i] };
+            };
+        };
+        class Iterator
+        {
+        private:
+            const std::uint8_t* At;
+            const std::uint8_t* End;
+        public:
+            constexpr explicit Iterator(const std::uint8_t* At, const std::uint8_t* End)
+                : At{ At }, End{ End }
+            {
+                Check();
+            };
+            constexpr Game operator *() const &
+            {
+                Game Ga{};
+                Ga.Re = static_cast<Result>(At[0] & Box);
+                Ga.Fo = static_cast<Forbidden>((At[0] >> 2) & Box);
+                Ga.Count = At[1];
+                Ga.Moves = At + 2;
+                return Ga;
+            };
+            constexpr Iterator& operator ++()
+            {
+                At += 2 + At[1];
+                Check();
+                return *this;
+            };
+            constexpr Iterator& operator ++(int) = delete;
+            friend constexpr bool operator ==(const Iterator& L, const Iterator& R)
+            {
+                return L.At == R.At;
+            };
+            friend constexpr bool operator !=(const Iterator& L, const Iterator& R)
+            {
+                return L.At != R.At;
+            };
+        private:
+            // A game running past the end of the file, or with more moves than the 225 points of the Board, ends
+            // the walk there, so that every Game walked fits on a Board.
+            constexpr void Check() &
+            {
+                if (End - At < 2 || At[1] > 225u || End - At < 2 + At[1]) { At = End; }
+            };
+        };
+        class Writer
+        {
+        private:
+            std::ofstream File;
+        public:
+            explicit Writer(const std::string& Path)
+                : File{ Path, std::ios::binary | std::ios::trunc }
+            {
+                File.write(Magic, sizeof(Magic));
+            };
+            explicit operator bool() const &
+            {
+                return static_cast<bool>(File);
+            };
+            // Returns false, writing nothing, for a Count that does not fit on a Board.
+            bool Write(const Position* Moves, int Count, Result Re, Forbidden Fo) &
+            {
+                if (Count < 0 || Count > 225) { return false; }
+                char Bytes[227]{};
+                Bytes[0] = static_cast<char>(static_cast<std::uint32_t>(Re) | (static_cast<std::uint32_t>(Fo) << 2));
+                Bytes[1] = static_cast<char>(Count);
+                for (int i = 0; i < Count; ++i) { Bytes[i + 2] = static_cast<char>(static_cast<std::uint8_t>(Moves[i])); }
+                File.write(Bytes, Count + 2);
+                return true;
+            };
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        MappedFile Ma;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit Archive(const std::string& Path)
+            : Ma{ Path }
+        {
+            Ma.Sequential();
+        };
+        // Whether the file is mapped and begins with the Magic.
+        bool Valid() const &
+        {
+            return Ma.Size() >= sizeof(Magic) && std::memcmp(Ma.Data(), Magic, sizeof(Magic)) == 0;
+        };
+        std::size_t Bytes() const &
+        {
+            return Ma.Size();
+        };
+        Iterator begin() const &
+        {
+            if (!Valid()) { return end(); }
+            return Iterator{ Ma.Data() + sizeof(Magic), Ma.Data() + Ma.Size() };
+        };
+        Iterator end() const &
+        {
+            return Iterator{ Ma.Data() + Ma.Size(), Ma.Data() + Ma.Size() };
+        };
+#pragma endregion
+    };
+}
@@ -0,0 +1,673 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Adjudicator.h"
+#include "Evaluator.h"
+#include "ForbiddenMap.h"
+#include "MoveGenerator.h"
+#include "Renderer.h"
+#include "Solver.h"
+#include "TranspositionTable.h"
+namespace Gomoku
+{
+    class Benchmark
+    {
+#pragma region helper-classes
+    private:
+        // Each record ends with the probed move, which the MakeResult shall judge as Expected.
+        struct Pathology
+        {
+        public:
+            const char* Name;
+            const char* Record;
+            Forbidden Expected;
+        };
+#pragma endregion
+#pragma region constants
+    private:
+        static constexpr const Pathology Corpus[]{
+            Pathology{ "simple-three-three", "h8 a1 i8 a2 g9 a3 g10 b1 g8", Forbidden::ThreeThree },
+            Pathology{ "simple-four-four", "h8 a1 i8 a2 j8 a3 g10 b1 g11 b2 g12 b3 g8", Forbidden::FourFour },
+            Pathology{ "simple-overline", "h8 a1 i8 a2 j8 a3 l8 b1 m8 b2 k8", Forbidden::Overline },
+            Pathology{ "deep-14-a", "h8 h12 j2 d1 a6 n7 e14 c10 f12 f9 i4 d7 j6 d4 g14 k13 b14 c6 o7 e13 h1 c11 b9 o8 e9 n1 o5 d13 k9 e7 e10 i8 l2 a2 i5 g2 e12 g4 l9 i11 h3 k7 c15 n9 j5 f3 f11 c13 h7 n12 j3 g13 j8", Forbidden::None },
+            Pathology{ "deep-14-b", "h8 c4 n9 d3 k6 d14 m6 f14 b12 a8 o4 e7 m5 k2 c11 j2 h5 f10 a7 m1 b6 e2 b4 f7 i7 j14 h6 b8 n7 l12 l5 f5 k7 m9 f4", Forbidden::None },
+            Pathology{ "deep-14-c", "h8 b6 e7 f1 b8 h4 e4 d1 l5 c14 f2 g1 h1 f15 c2 d10 g10 m12 k10 f12 c10 d4 f10 a10 c8 h12 j8 d3 g7 l12 k7 e2 e1 i1 k4 m15 f11 m10 e5 b7 f7", Forbidden::None },
+            Pathology{ "deep-12-four-four", "h8 c4 m10 f11 d15 n12 d12 g10 a3 d2 c14 f15 h14 k14 b7 c2 i2 m13 g12 m4 l14 i10 j10 g15 i15 k1 g8 h1 j13 k2 f9 m12 i7 k11 f1 l5 b14 b8 f6 m7 i4 a8 a15 a1 d10 m1 d6 o3 f4 e5 k15 o15 j11 g11 k13 o8 g3 k6 a6 l12 c8 n4 h2 i8 a9 d13 g4 e9 h4 j9 h5 l9 m6 c7 h6", Forbidden::FourFour },
+            Pathology{ "deep-11-three-three", "h8 h2 h5 a5 j6 l6 k15 c2 l1 f2 g7 i4 n15 c11 c15 e15 e1 a2 h11 o14 a3 d15 g5 n5 e10 c3 o5 e3 m9 d5 g2 f9 j7 b10 k4 h14 b9 m1 e2 o9 i13 l15 a14 c1 l14 d7 g1 f6 j12 h3 b12 h15 m15 j4 i7", Forbidden::ThreeThree },
+            Pathology{ "deep-10-three-three", "h8 g14 n14 f5 o8 j4 l8 m6 b4 d7 a9 d12 a11 m12 d9 c5 e10 g3 i7 n13 h11 b14 k4 b13 g1 o13 k7 f1 h9 a6 g6 c9 i6 o11 f3 f4 b6 i4 a13 m4 b8 n9 c2 n7 e15 m8 k3 k14 a2 b10 a8 i2 a5 d5 m13 d2 h13 f13 b5 l11 e11 o2 j10 n12 a3 f14 b3 o10 m11 e8 d4 i3 g9 o1 h6", Forbidden::ThreeThree },
+            Pathology{ "deep-7-overline", "h8 k5 o9 d10 g2 n14 n2 k1 c13 k4 i2 b15 g10 i8 b9 i13 h10 f12 f11 a15 m3 o13 i7 i9 n5 h2 e2 b6 f1 b14 a5 f13 i15 j4 d3 g15 i12 b11 n15 a3 l13 j1 o1 f5 a8 m14 e9 o8 f2 d8 j11 m8 l10 f9 n4 c6 i11 e4 j12 n7 f15 d5 l14 e14 l7 m9 e13 l3 k11 a12 l15 l8 g11 e1 m5 c9 h11", Forbidden::Overline },
+        };
+#pragma endregion
+#pragma region constructors-and-methods
+    private:
+        static inline long Budget = 200;
+        static inline const char* Filter = nullptr;
+        static inline int Failures = 0;
+        static bool Replay(const char* Record, Board& Bo, Position& Probe)
+        {
+            std::vector<Position> Moves{};
+            if (!Notation::ParseGame(Record, Moves) || Moves.empty()) { return false; }
+            Referee Rf{ Bo };
+            for (std::size_t i = 0; i + 1 < Moves.size(); ++i)
+            {
+                if (!Bo.CanPutChess(Moves[i]) || Rf.PutChess(Moves[i]).Re != Result::None) { return false; }
+            }
+            Probe = Moves.back();
+            return Bo.CanPutChess(Probe);
+        };
+        // Runs Fn(Iterations) with Iterations doubled until a run takes a fifth of the Budget, then reports the
+        // least and the median of 5 such runs, returning the median. Fn returns a checksum so that the work
+        // cannot be discarded.
+        template <typename F>
+        static double Measure(const std::string& Name, F&& Fn)
+        {
+            if (Filter != nullptr && Name.find(Filter) == std::string::npos) { return 0e0; }
+            std::chrono::nanoseconds Target = std::chrono::milliseconds{ Budget } / 5;
+            std::uint64_t Iterations = 1u;
+            std::uint64_t Sum = 0u;
+            while (true)
+            {
+                std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+                Sum += Fn(Iterations);
+                if (std::chrono::steady_clock::now() - Begin >= Target || Iterations >= (1ull << 40)) { break; }
+                Iterations *= 2u;
+            }
+            double Runs[5]{};
+            for (double& Ru : Runs)
+            {
+                std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+                Sum += Fn(Iterations);
+                Ru = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Begin).count() / Iterations;
+            }
+            std::sort(std::begin(Runs), std::end(Runs));
+            std::printf("%-46s %12.2f ns/op %12.2f min %14llu ops  %016llx\n", Name.c_str(), Runs[2], Runs[0],
+                static_cast<unsigned long long>(Iterations), static_cast<unsigned long long>(Sum));
+            return Runs[2];
+        };
+        static void Lines(std::vector<std::uint32_t>& All, std::vector<std::uint32_t>& Threes, std::vector<Position>& Centres)
+        {
+            for (const Pathology& Pa : Corpus)
+            {
+                Board Bo{};
+                Position Probe = Position::Null;
+                if (!Replay(Pa.Record, Bo, Probe)) { continue; }
+                for (int Y = 0; Y < 15; ++Y)
+                {
+                    for (int X = 0; X < 15; ++X)
+                    {
+                        Position Po{ X, Y };
+                        for (int Or = 0; Or < 4; ++Or)
+                        {
+                            std::uint32_t Li = Bo.GetLine(Po, static_cast<Orientation>(Or));
+                            All.push_back(Li);
+                            std::uint32_t MySide = Counter::MySide(Li, true);
+                            if (Bo[Po] == Chess::Black && Counter::Classify(MySide, true) == Counter::Match::T3)
+                            {
+                                Threes.push_back(MySide);
+                                Centres.push_back(Po);
+                            }
+                        }
+                    }
+                }
+            }
+        };
+        template <typename B>
+        static void GetLines(const char* Kind, const B& Bo)
+        {
+            static constexpr const char* Names[4]{ "Horizontal", "Vertical", "Downward", "Upward" };
+            for (int Or = 0; Or < 4; ++Or)
+            {
+                Measure(std::string{ Kind } + ".GetLine/" + Names[Or], [&](std::uint64_t Iterations)
+                {
+                    std::uint64_t Sum = 0u;
+                    for (std::uint64_t i = 0; i < Iterations; ++i)
+                    {
+                        std::uint32_t Index = static_cast<std::uint32_t>(i % 225u);
+                        Sum += Bo.GetLine(Position{ static_cast<int>(Index % 15u), static_cast<int>(Index / 15u) }, static_cast<Orientation>(Or));
+                    }
+                    return Sum;
+                });
+            }
+        };
+        template <std::size_t N>
+        static void Exists(const char* Name, const std::vector<std::uint32_t>& Sides, const Counter::Pack(&Cases)[N])
+        {
+            Measure(std::string{ "Counter.Exists/" } + Name, [&](std::uint64_t Iterations)
+            {
+                std::uint64_t Sum = 0u;
+                std::size_t j = 0;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    Sum += Counter::Exists(Sides[j], Cases);
+                    if (++j == Sides.size()) { j = 0; }
+                }
+                return Sum;
+            });
+        };
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--ms") == 0 && i + 1 < argc) { Budget = std::atol(argv[++i]); }
+                else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) { Filter = argv[++i]; }
+                else
+                {
+                    std::fprintf(stderr, "usage: %s [--ms N] [--filter substring]\n", argv[0]);
+                    return 1;
+                }
+            }
+            for (const Pathology& Pa : Corpus)
+            {
+                Board Bo{};
+                Position Probe = Position::Null;
+                if (!Replay(Pa.Record, Bo, Probe))
+                {
+                    std::fprintf(stderr, "%s: the record cannot be replayed\n", Pa.Name);
+                    ++Failures;
+                    continue;
+                }
+                Referee Rf{ Bo };
+                Bo[Probe] = Bo.IsBlackTurn() ? Chess::Black : Chess::White;
+                Forbidden Fo = Rf.MakeResult(Probe).Fo;
+                if (Fo != Pa.Expected)
+                {
+                    std::fprintf(stderr, "%s: expected %s but judged %s\n", Pa.Name, Notation::Name(Pa.Expected), Notation::Name(Fo));
+                    ++Failures;
+                }
+            }
+            for (std::uint32_t Li = 0u; Li < (1u << 18); ++Li)
+            {
+                std::uint32_t Full = Li | 0x3FFC0000u | (Li << 30);
+                if (Counter::MySide(Full, true) != Counter::MySideByBoxes(Full, true) || Counter::MySide(Full, false) != Counter::MySideByBoxes(Full, false))
+                {
+                    std::fprintf(stderr, "Counter.MySide disagrees with Counter.MySideByBoxes on %05x\n", Li);
+                    ++Failures;
+                    break;
+                }
+            }
+            for (std::uint32_t Li = 0u; Li < (1u << 18); ++Li)
+            {
+                Counter::Match Black = Counter::Exists(Li, Counter::T6) ? Counter::Match::T6 : Counter::Exists(Li, Counter::T5) ? Counter::Match::T5
+                    : Counter::Exists(Li, Counter::D4) ? Counter::Match::D4 : Counter::Exists(Li, Counter::T4) ? Counter::Match::T4
+                    : Counter::Exists(Li, Counter::T3) ? Counter::Match::T3 : Counter::Match::None;
+                Counter::Match White = Counter::Exists(Li, Counter::T5) ? Counter::Match::T5 : Counter::Match::None;
+                int Group = 0;
+                while (Group < 12 && (Li & Counter::T3[Group].Mask) != Counter::T3[Group].Case) { ++Group; }
+                if (Counter::Classify(Li, true) != Black || Counter::Classify(Li, false) != White || (Group < 12 && Counter::Group3(Li) != Group))
+                {
+                    std::fprintf(stderr, "Counter.Classify disagrees with Counter.Exists on %05x\n", Li);
+                    ++Failures;
+                    break;
+                }
+            }
+            TranspositionTable Table{ 1u };
+            for (const Pathology& Pa : Corpus)
+            {
+                Board Bo{};
+                Position Probe = Position::Null;
+                if (!Replay(Pa.Record, Bo, Probe)) { continue; }
+                Table.StoreSymmetric(Bo, TranspositionTable::Entry{ Probe, 7, TranspositionTable::Bound::Exact, Bo.Rounds() });
+                for (int Tr = 0; Tr < 8; ++Tr)
+                {
+                    TranspositionTable::Entry En{};
+                    if (!Table.ProbeSymmetric(Symmetry::Apply(Bo, Tr), En) || En.Move != Symmetry::Apply(Probe, Tr) || En.Score != Bo.Rounds())
+                    {
+                        std::fprintf(stderr, "%s: TranspositionTable.ProbeSymmetric misses the transform %d\n", Pa.Name, Tr);
+                        ++Failures;
+                        break;
+                    }
+                }
+            }
+            Board Mid{};
+            Position Last = Position::Null;
+            Replay(Corpus[3].Record, Mid, Last);
+            LineBoard MidLines{ Mid };
+            GetLines("Board", Mid);
+            GetLines("LineBoard", MidLines);
+            std::vector<std::uint32_t> All{};
+            std::vector<std::uint32_t> Threes{};
+            std::vector<Position> Centres{};
+            Lines(All, Threes, Centres);
+            for (int Bk = 1; Bk >= 0; --Bk)
+            {
+                Measure(Bk ? "Counter.MySide/Black" : "Counter.MySide/White", [&](std::uint64_t Iterations)
+                {
+                    std::uint64_t Sum = 0u;
+                    std::size_t j = 0;
+                    for (std::uint64_t i = 0; i < Iterations; ++i)
+                    {
+                        Sum += Counter::MySide(All[j], Bk != 0);
+                        if (++j == All.size()) { j = 0; }
+                    }
+                    return Sum;
+                });
+            }
+            for (int Bk = 1; Bk >= 0; --Bk)
+            {
+                Measure(Bk ? "Counter.MySideByBoxes/Black" : "Counter.MySideByBoxes/White", [&](std::uint64_t Iterations)
+                {
+                    std::uint64_t Sum = 0u;
+                    std::size_t j = 0;
+                    for (std::uint64_t i = 0; i < Iterations; ++i)
+                    {
+                        Sum += Counter::MySideByBoxes(All[j], Bk != 0);
+                        if (++j == All.size()) { j = 0; }
+                    }
+                    return Sum;
+                });
+            }
+            std::vector<std::uint32_t> Sides{};
+            for (std::uint32_t Li : All) { Sides.push_back(Counter::MySide(Li, true)); }
+            Exists("T6", Sides, Counter::T6);
+            Exists("T5", Sides, Counter::T5);
+            Exists("D4", Sides, Counter::D4);
+            Exists("T4", Sides, Counter::T4);
+            Exists("T3", Sides, Counter::T3);
+            Measure("Counter.Classify", [&](std::uint64_t Iterations)
+            {
+                std::uint64_t Sum = 0u;
+                std::size_t j = 0;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    Sum += static_cast<std::uint64_t>(Counter::Classify(Sides[j], true));
+                    if (++j == Sides.size()) { j = 0; }
+                }
+                return Sum;
+            });
+            if (!Threes.empty())
+            {
+                Measure("BasicReferee.FindForbidPos", [&](std::uint64_t Iterations)
+                {
+                    Board Bo{};
+                    Referee Rf{ Bo };
+                    std::uint64_t Sum = 0u;
+                    std::size_t j = 0;
+                    for (std::uint64_t i = 0; i < Iterations; ++i)
+                    {
+                        Sum += static_cast<std::uint32_t>(Rf.FindForbidPos(Threes[j], Centres[j]).P1());
+                        if (++j == Threes.size()) { j = 0; }
+                    }
+                    return Sum;
+                });
+            }
+            for (const Pathology& Pa : Corpus)
+            {
+                Board Bo{};
+                Position Probe = Position::Null;
+                if (!Replay(Pa.Record, Bo, Probe)) { continue; }
+                Measure(std::string{ "BasicReferee.S3Forbid/" } + Pa.Name, [&](std::uint64_t Iterations)
+                {
+                    Referee Rf{ Bo };
+                    std::uint64_t Sum = 0u;
+                    for (std::uint64_t i = 0; i < Iterations; ++i) { Sum += Rf.S3Forbid(Probe); }
+                    return Sum;
+                });
+                Measure(std::string{ "BasicReferee.MakeResult/" } + Pa.Name, [&](std::uint64_t Iterations)
+                {
+                    Referee Rf{ Bo };
+                    Chess Side = Bo.IsBlackTurn() ? Chess::Black : Chess::White;
+                    std::uint64_t Sum = 0u;
+                    for (std::uint64_t i = 0; i < Iterations; ++i)
+                    {
+                        Bo[Probe] = Side;
+                        Sum += static_cast<std::uint64_t>(Rf.MakeResult(Probe).Fo);
+                        Bo[Probe] = Chess::None;
+                    }
+                    return Sum;
+                });
+            }
+            std::vector<std::vector<Position>> Games{};
+            for (const Pathology& Pa : Corpus)
+            {
+                Games.emplace_back();
+                Notation::ParseGame(Pa.Record, Games.back());
+            }
+            Measure("Adjudicator.Adjudicate/corpus", [&](std::uint64_t Iterations)
+            {
+                std::uint64_t Sum = 0u;
+                std::size_t j = 0;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    Sum += static_cast<std::uint64_t>(Adjudicator::Adjudicate<Board>(Games[j].data(), static_cast<int>(Games[j].size())).Played);
+                    if (++j == Games.size()) { j = 0; }
+                }
+                return Sum;
+            });
+            std::vector<Position> Game{};
+            Notation::ParseGame(Corpus[3].Record, Game);
+            Game.pop_back();
+            const Evaluator Empty{ Board{} };
+            std::vector<Evaluator> Prefixes{};
+            std::vector<Board> Boards{};
+            Evaluator Played = Empty;
+            for (Position Po : Game)
+            {
+                Evaluator Before = Played;
+                Played.Update(Po);
+                Evaluator Full{ Played.Plain() };
+                Evaluator Undone = Played;
+                Undone.Undo(Po);
+                bool Same = Full.Evaluate() == Played.Evaluate() && Full.FivePoints(true) == Played.FivePoints(true) && Full.FivePoints(false) == Played.FivePoints(false);
+                bool Back = Before.Evaluate() == Undone.Evaluate() && Before.FivePoints(true) == Undone.FivePoints(true) && Before.FivePoints(false) == Undone.FivePoints(false);
+                for (int Sh = 0; Sh < 8; ++Sh)
+                {
+                    for (bool Bk : { true, false })
+                    {
+                        Same = Same && Full.Count(Bk, static_cast<Evaluator::Shape>(Sh)) == Played.Count(Bk, static_cast<Evaluator::Shape>(Sh));
+                        Back = Back && Before.Count(Bk, static_cast<Evaluator::Shape>(Sh)) == Undone.Count(Bk, static_cast<Evaluator::Shape>(Sh));
+                    }
+                }
+                if (!Same || !Back)
+                {
+                    std::fprintf(stderr, "Evaluator.%s disagrees with Evaluator.Rescan after %s\n", Same ? "Undo" : "Update", Notation::Format(Po).c_str());
+                    ++Failures;
+                    break;
+                }
+                Prefixes.push_back(Played);
+                Boards.push_back(Played.Plain());
+            }
+            double Update = Measure("Evaluator.Update/deep-14-a", [&](std::uint64_t Iterations)
+            {
+                Evaluator Ev = Empty;
+                std::uint64_t Sum = 0u;
+                std::size_t j = 0;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    if (j == Game.size())
+                    {
+                        Ev = Empty;
+                        j = 0;
+                    }
+                    Ev.Update(Game[j++]);
+                    Sum += static_cast<std::uint64_t>(Ev.Evaluate());
+                }
+                return Sum;
+            });
+            double Rescan = Measure("Evaluator.Rescan/deep-14-a", [&](std::uint64_t Iterations)
+            {
+                std::uint64_t Sum = 0u;
+                std::size_t j = 0;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    Prefixes[j].Rescan();
+                    Sum += static_cast<std::uint64_t>(Prefixes[j].Evaluate());
+                    if (++j == Prefixes.size()) { j = 0; }
+                }
+                return Sum;
+            });
+            Measure("Evaluator.Update+Undo/deep-14-a", [&](std::uint64_t Iterations)
+            {
+                std::uint64_t Sum = 0u;
+                std::size_t j = 0;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    Evaluator& Ev = Prefixes[j];
+                    Position Po = j + 1 < Game.size() ? Game[j + 1] : Game[0];
+                    if (Ev.Plain()[Po] == Chess::None)
+                    {
+                        Ev.Update(Po);
+                        Sum += static_cast<std::uint64_t>(Ev.Evaluate());
+                        Ev.Undo(Po);
+                    }
+                    if (++j == Prefixes.size()) { j = 0; }
+                }
+                return Sum;
+            });
+            // Games crowding the 2 outer rings, where the FindForbidPos clamps the points of many threes off the
+            // Board, and the Footprint of each Forbid shall stay on it.
+            std::vector<std::vector<Position>> Checked = Games;
+            std::mt19937 Rng{ 15u };
+            for (int g = 0; g < 48; ++g)
+            {
+                Board Bo{};
+                Referee Rf{ Bo };
+                std::vector<Position>& Ga = Checked.emplace_back(1u, Position{ 7, 7 });
+                Rf.PutChess(Ga[0]);
+                for (int Tries = 0; Tries < 4096 && Ga.size() < 96u; ++Tries)
+                {
+                    int Ring = static_cast<int>(Rng() % 2u);
+                    int Along = static_cast<int>(Rng() % 15u);
+                    int Side = static_cast<int>(Rng() % 4u);
+                    Position Po = Side == 0 ? Position{ Along, Ring } : Side == 1 ? Position{ Ring, Along } : Side == 2 ? Position{ Along, 14 - Ring } : Position{ 14 - Ring, Along };
+                    if (!Bo.CanPutChess(Po) || (Bo.IsBlackTurn() && Rf.Forbid(Po) != Forbidden::None)) { continue; }
+                    Ga.push_back(Po);
+                    if (Rf.PutChess(Po).Re != Result::None) { break; }
+                    LineBoard Lb{ Bo };
+                    bool Inside = true;
+                    for (int Y = 0; Y < 15 && Inside; ++Y)
+                    {
+                        for (int X = 0; X < 15 && Inside; ++X)
+                        {
+                            struct
+                            {
+                                Footprint Fp;
+                                std::uint32_t Past;
+                            } Guarded{};
+                            LineReferee Lr{ Lb, nullptr, &Guarded.Fp };
+                            Lr.Forbid(Position{ X, Y });
+                            for (std::uint32_t Li : Guarded.Fp.Rows) { Inside = Inside && (Li >> 15) == 0u; }
+                            Inside = Inside && Guarded.Past == 0u;
+                        }
+                    }
+                    if (!Inside)
+                    {
+                        std::fprintf(stderr, "Footprint.Add leaves the Board after %s\n", Notation::Format(Po).c_str());
+                        ++Failures;
+                        break;
+                    }
+                }
+            }
+            for (const std::vector<Position>& Ga : Checked)
+            {
+                ForbiddenMap Fm{ Board{} };
+                Board Bo{};
+                Referee Rf{ Bo };
+                bool Same = true;
+                for (std::size_t i = 0; i < Ga.size() && Same && Bo.CanPutChess(Ga[i]); ++i)
+                {
+                    Rf.PutChess(Ga[i]);
+                    Fm.Update(Ga[i]);
+                    for (int Y = 0; Y < 15 && Same; ++Y)
+                    {
+                        std::uint32_t Row = 0u;
+                        for (int X = 0; X < 15; ++X)
+                        {
+                            if (Rf.Forbid(Position{ X, Y }) != Forbidden::None) { Row |= Bit << X; }
+                        }
+                        Same = Row == Fm.Row(Y);
+                    }
+                    if (!Same)
+                    {
+                        std::fprintf(stderr, "ForbiddenMap.Update disagrees with BasicReferee.Forbid after %s\n", Notation::Format(Ga[i]).c_str());
+                        ++Failures;
+                    }
+                }
+            }
+            const ForbiddenMap Blank{ Board{} };
+            double Mapped = Measure("ForbiddenMap.Update/deep-14-a", [&](std::uint64_t Iterations)
+            {
+                ForbiddenMap Fm = Blank;
+                std::uint64_t Sum = 0u;
+                std::size_t j = 0;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    if (j == Game.size())
+                    {
+                        Fm = Blank;
+                        j = 0;
+                    }
+                    Fm.Update(Game[j++]);
+                    Sum += static_cast<std::uint64_t>(Fm.Count());
+                }
+                return Sum;
+            });
+            double Scan = Measure("MoveGenerator.Allowed/deep-14-a", [&](std::uint64_t Iterations)
+            {
+                std::uint64_t Sum = 0u;
+                std::size_t j = 0;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    for (int Index = 0; Index < 225; ++Index)
+                    {
+                        Position Po{ Index % 15, Index / 15 };
+                        if (Boards[j][Po] == Chess::None) { Sum += MoveGenerator::Allowed(Boards[j], Po); }
+                    }
+                    if (++j == Boards.size()) { j = 0; }
+                }
+                return Sum;
+            });
+            if (Mapped > 0 && Scan > 0)
+            {
+                std::printf("%-46s %12.0f calls/s %12.0f scans %8.1fx\n", "ForbiddenMap.Update/calls", 1e9 / Mapped, 1e9 / Scan, Scan / Mapped);
+            }
+            std::vector<LineBoard> Positions{ Boards.begin(), Boards.end() };
+            for (int Radius = 1; Radius <= 2; ++Radius)
+            {
+                Measure("MoveGenerator.Generate/radius-" + std::to_string(Radius), [&](std::uint64_t Iterations)
+                {
+                    MoveGenerator::Buffer Moves{};
+                    std::uint64_t Sum = 0u;
+                    std::size_t j = 0;
+                    for (std::uint64_t i = 0; i < Iterations; ++i)
+                    {
+                        Sum += static_cast<std::uint64_t>(MoveGenerator::Generate(Positions[j], Moves, Radius));
+                        Sum += static_cast<std::uint32_t>(Moves[0].Po);
+                        if (++j == Positions.size()) { j = 0; }
+                    }
+                    return Sum;
+                });
+            }
+            if (Update > 0 && Rescan > 0)
+            {
+                std::printf("%-46s %12.0f calls/s %12.0f rescan %8.1fx\n", "Evaluator.Update/calls", 1e9 / Update, 1e9 / Rescan, Rescan / Update);
+            }
+            Board Square{};
+            Position Unused = Position::Null;
+            Replay("h8 a1 i8 a15 h9 o1 i9 o15 f6", Square, Unused);
+            for (Solver::Mode Mo : { Solver::Mode::Vcf, Solver::Mode::Vct })
+            {
+                Solver Sv{ 1u };
+                std::uint64_t Nodes = 0u;
+                std::chrono::nanoseconds Elapsed{ 0 };
+                std::vector<Position> Line{};
+                std::string Name = Mo == Solver::Mode::Vcf ? "Solver.Solve/vcf-square" : "Solver.Solve/vct-square";
+                Measure(Name, [&](std::uint64_t Iterations)
+                {
+                    std::uint64_t Sum = 0u;
+                    for (std::uint64_t i = 0; i < Iterations; ++i)
+                    {
+                        Sv.Clear();
+                        Sum += Sv.Solve(Square, Mo, 3, Line);
+                        Nodes += Sv.LastStats().Nodes;
+                        Elapsed += Sv.LastStats().Elapsed;
+                    }
+                    return Sum;
+                });
+                if (Nodes > 0u) { std::printf("%-46s %12.0f nodes/s\n", (Name + "/nodes").c_str(), Nodes * 1e9 / std::max<std::int64_t>(Elapsed.count(), 1)); }
+            }
+            BoardRenderer Incremental{ std::make_unique<Bitmap>(0, 0) };
+            BoardRenderer Full{ std::make_unique<Bitmap>(0, 0) };
+            Incremental.Prepare(Layout{});
+            Full.Prepare(Layout{});
+            Incremental.RenderClient(Board{});
+            Board Drawn{};
+            Referee Rd{ Drawn };
+            for (Position Po : Game)
+            {
+                Incremental.PaintShadow(Po);
+                Incremental.ClearGrid(Po);
+                Incremental.PaintChess(Po, Drawn.IsBlackTurn());
+                Rd.PutChess(Po);
+            }
+            Full.RenderClient(Drawn);
+            const Bitmap& Painted = static_cast<const Bitmap&>(Incremental.Buffer());
+            const Bitmap& Rendered = static_cast<const Bitmap&>(Full.Buffer());
+            for (int Y = 0; Y < Painted.Height(); ++Y)
+            {
+                if (!std::equal(Painted.Row(Y), Painted.Row(Y) + Painted.Width(), Rendered.Row(Y)))
+                {
+                    std::fprintf(stderr, "BoardRenderer.PaintChess disagrees with BoardRenderer.RenderClient on row %d\n", Y);
+                    ++Failures;
+                    break;
+                }
+            }
+            Measure("BoardRenderer.Prepare", [&](std::uint64_t Iterations)
+            {
+                std::uint64_t Sum = 0u;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    Layout La{};
+                    La.SetParams(80 + static_cast<int>(i % 2u), 3, 40);
+                    Sum += Full.Prepare(La);
+                }
+                return Sum;
+            });
+            Full.Prepare(Layout{});
+            Measure("BoardRenderer.RenderClient/deep-14-a", [&](std::uint64_t Iterations)
+            {
+                std::uint64_t Sum = 0u;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    Full.RenderClient(Drawn);
+                    Sum += static_cast<std::uint64_t>(Full.TakeDirty().Width);
+                }
+                return Sum;
+            });
+            Measure("BoardRenderer.PaintChess/deep-14-a", [&](std::uint64_t Iterations)
+            {
+                std::uint64_t Sum = 0u;
+                std::size_t j = 0;
+                for (std::uint64_t i = 0; i < Iterations; ++i)
+                {
+                    Full.PaintChess(Game[j], j % 2u == 0u);
+                    Sum += static_cast<std::uint64_t>(Full.TakeDirty().Width);
+                    if (++j == Game.size()) { j = 0; }
+                }
+                return Sum;
+            });
+            if (Failures != 0) { std::fprintf(stderr, "%d of the corpus failed\n", Failures); }
+            return Failures != 0 ? 2 : 0;
+        };
+#pragma endregion
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Benchmark::Main(argc, argv);
+};
@@ -0,0 +1,337 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <bit>
+#include <cstdint>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "Referee.h"
+namespace Gomoku
+{
+    struct Bitboard
+    {
+#pragma region helper-classes
+    public:
+#if defined(__AVX2__)
+        struct Plane
+        {
+        public:
+            __m256i W;
+            Plane()
+                : W{ _mm256_setzero_si256() }
+            {};
+            explicit Plane(__m256i W)
+                : W{ W }
+            {};
+            static Plane Rows()
+            {
+                return Plane{ _mm256_set_epi16(0, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF) };
+            };
+            std::uint64_t Lane(int i) const &
+            {
+                alignas(32) std::uint64_t Result[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(Result), W);
+                return Result[i];
+            };
+            void Set(int Index) &
+            {
+                alignas(32) std::uint64_t Result[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(Result), W);
+                Result[Index >> 6] |= 1ull << (Index & 63);
+                W = _mm256_load_si256(reinterpret_cast<const __m256i*>(Result));
+            };
+            void Reset(int Index) &
+            {
+                alignas(32) std::uint64_t Result[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(Result), W);
+                Result[Index >> 6] &= ~(1ull << (Index & 63));
+                W = _mm256_load_si256(reinterpret_cast<const __m256i*>(Result));
+            };
+            bool Any() const &
+            {
+                return !_mm256_testz_si256(W, W);
+            };
+            friend Plane operator &(Plane L, Plane R)
+            {
+                return Plane{ _mm256_and_si256(L.W, R.W) };
+            };
+            friend Plane operator |(Plane L, Plane R)
+            {
+                return Plane{ _mm256_or_si256(L.W, R.W) };
+            };
+            static Plane AndNot(Plane L, Plane R)
+            {
+                return Plane{ _mm256_andnot_si256(R.W, L.W) };
+            };
+            template <int Dx, int Dy>
+            static Plane Forward(Plane P)
+            {
+                __m256i W = P.W;
+                if constexpr (Dy == 1) { W = _mm256_alignr_epi8(_mm256_permute2x128_si256(W, W, 0x81), W, 2); }
+                if constexpr (Dx == 1) { W = _mm256_srli_epi16(W, 1); }
+                else if constexpr (Dx == -1) { W = _mm256_slli_epi16(W, 1); }
+                return Plane{ W };
+            };
+            template <int Dx, int Dy>
+            static Plane Backward(Plane P)
+            {
+                __m256i W = P.W;
+                if constexpr (Dy == 1) { W = _mm256_alignr_epi8(W, _mm256_permute2x128_si256(W, W, 0x08), 14); }
+                if constexpr (Dx == 1) { W = _mm256_slli_epi16(W, 1); }
+                else if constexpr (Dx == -1) { W = _mm256_srli_epi16(W, 1); }
+                return Plane{ W };
+            };
+        };
+#else
+        struct Plane
+        {
+        public:
+            std::uint64_t W[4];
+            constexpr Plane()
+                : W{}
+            {};
+            static constexpr Plane Rows()
+            {
+                Plane Result{};
+                for (int i = 0; i < 4; ++i) { Result.W[i] = 0x7FFF7FFF7FFF7FFFull; }
+                Result.W[3] &= 0x0000FFFFFFFFFFFFull;
+                return Result;
+            };
+            constexpr std::uint64_t Lane(int i) const &
+            {
+                return W[i];
+            };
+            constexpr void Set(int Index) &
+            {
+                W[Index >> 6] |= 1ull << (Index & 63);
+            };
+            constexpr void Reset(int Index) &
+            {
+                W[Index >> 6] &= ~(1ull << (Index & 63));
+            };
+            constexpr bool Any() const &
+            {
+                return (W[0] | W[1] | W[2] | W[3]) != 0u;
+            };
+            friend constexpr Plane operator &(Plane L, Plane R)
+            {
+                for (int i = 0; i < 4; ++i) { L.W[i] &= R.W[i]; }
+                return L;
+            };
+            friend constexpr Plane operator |(Plane L, Plane R)
+            {
+                for (int i = 0; i < 4; ++i) { L.W[i] |= R.W[i]; }
+                return L;
+            };
+            static constexpr Plane AndNot(Plane L, Plane R)
+            {
+                for (int i = 0; i < 4; ++i) { L.W[i] &= ~R.W[i]; }
+                return L;
+            };
+            static constexpr Plane Right(Plane P, int Shift)
+            {
+                Plane Result{};
+                for (int i = 0; i < 4; ++i)
+                {
+                    std::uint64_t Next = i < 3 ? P.W[i + 1] : 0u;
+                    Result.W[i] = (P.W[i] >> Shift) | (Next << (64 - Shift));
+                }
+                return Result;
+            };
+            static constexpr Plane Left(Plane P, int Shift)
+            {
+                Plane Result{};
+                for (int i = 0; i < 4; ++i)
+                {
+                    std::uint64_t Prev = i > 0 ? P.W[i - 1] : 0u;
+                    Result.W[i] = (P.W[i] << Shift) | (Prev >> (64 - Shift));
+                }
+                return Result;
+            };
+            template <int Dx, int Dy>
+            static constexpr Plane Forward(Plane P)
+            {
+                return Right(P, Dy * 16 + Dx);
+            };
+            template <int Dx, int Dy>
+            static constexpr Plane Backward(Plane P)
+            {
+                return Left(P, Dy * 16 + Dx);
+            };
+        };
+#endif
+#pragma endregion
+#pragma region fields
+    private:
+        Plane Black;
+        Plane White;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        Bitboard()
+            : Black{}, White{}
+        {};
+        explicit Bitboard(const Board& Bo)
+            : Black{}, White{}
+        {
+            for (Board::ChessCRef Ch : Bo)
+            {
+                if (Ch == Chess::Black) { Put(Ch.Pos(), Chess::Black); }
+                else if (Ch == Chess::White) { Put(Ch.Pos(), Chess::White); }
+            }
+        };
+        static constexpr int Index(Position Po)
+        {
+            return Po.Y() * 16 + Po.X();
+        };
+        static int Count(Plane P)
+        {
+            int Result = 0;
+            for (int i = 0; i < 4; ++i) { Result += std::popcount(P.Lane(i)); }
+            return Result;
+        };
+        static bool Test(Plane P, Position Po)
+        {
+            int i = Index(Po);
+            return ((P.Lane(i >> 6) >> (i & 63)) & 1u) != 0u;
+        };
+        void Put(Position Po, Chess Ch) &
+        {
+            if (Po.X() == 15 || Po.Y() == 15) { return; }
+            int i = Index(Po);
+            Black.Reset(i);
+            White.Reset(i);
+            if (Ch == Chess::Black) { Black.Set(i); }
+            else if (Ch == Chess::White) { White.Set(i); }
+        };
+        Plane Stones(Chess Ch) const &
+        {
+            return Ch == Chess::Black ? Black : White;
+        };
+        Plane Empty() const &
+        {
+            return Plane::AndNot(Plane::Rows(), Black | White);
+        };
+        Plane Fives(Chess Ch) const &
+        {
+            Plane P = Stones(Ch);
+            return Run<1, 0>(P, 5) | Run<0, 1>(P, 5) | Run<1, 1>(P, 5) | Run<-1, 1>(P, 5);
+        };
+        Plane Overlines(Chess Ch) const &
+        {
+            Plane P = Stones(Ch);
+            return Run<1, 0>(P, 6) | Run<0, 1>(P, 6) | Run<1, 1>(P, 6) | Run<-1, 1>(P, 6);
+        };
+        Plane ExactFives(Chess Ch) const &
+        {
+            Plane P = Stones(Ch);
+            return Exact<1, 0>(P) | Exact<0, 1>(P) | Exact<1, 1>(P) | Exact<-1, 1>(P);
+        };
+        Plane StraightFours(Chess Ch) const &
+        {
+            Plane P = Stones(Ch);
+            Plane E = Empty();
+            return Straight<1, 0>(P, E) | Straight<0, 1>(P, E) | Straight<1, 1>(P, E) | Straight<-1, 1>(P, E);
+        };
+        Plane FivePoints(Chess Ch, bool Exactly) const &
+        {
+            Plane P = Stones(Ch);
+            Plane E = Empty();
+            Plane Result = Points<1, 0>(P, E, Exactly) | Points<0, 1>(P, E, Exactly) | Points<1, 1>(P, E, Exactly) | Points<-1, 1>(P, E, Exactly);
+            return Result & E;
+        };
+    private:
+        template <int Dx, int Dy>
+        static Plane Run(Plane P, int Length)
+        {
+            Plane Result = P;
+            Plane Step = P;
+            for (int i = 1; i < Length; ++i)
+            {
+                Step = Plane::template Forward<Dx, Dy>(Step);
+                Result = Result & Step;
+            }
+            return Result & Plane::Rows();
+        };
+        template <int Dx, int Dy>
+        static Plane Exact(Plane P)
+        {
+            Plane After = P;
+            for (int i = 0; i < 5; ++i) { After = Plane::template Forward<Dx, Dy>(After); }
+            Plane Result = Plane::AndNot(Run<Dx, Dy>(P, 5), Plane::template Backward<Dx, Dy>(P));
+            return Plane::AndNot(Result, After);
+        };
+        template <int Dx, int Dy>
+        static Plane Straight(Plane P, Plane E)
+        {
+            Plane Result = E;
+            Plane Step = P;
+            for (int i = 1; i < 5; ++i)
+            {
+                Step = Plane::template Forward<Dx, Dy>(Step);
+                Result = Result & Step;
+            }
+            Plane After = E;
+            for (int i = 0; i < 5; ++i) { After = Plane::template Forward<Dx, Dy>(After); }
+            return Result & After & Plane::Rows();
+        };
+        template <int Dx, int Dy>
+        static Plane Points(Plane P, Plane E, bool Exactly)
+        {
+            Plane A[5]{};
+            Plane F[5]{};
+            A[0] = P;
+            F[0] = E;
+            for (int i = 1; i < 5; ++i)
+            {
+                A[i] = Plane::template Forward<Dx, Dy>(A[i - 1]);
+                F[i] = Plane::template Forward<Dx, Dy>(F[i - 1]);
+            }
+            Plane Bound = Plane::Rows();
+            if (Exactly)
+            {
+                Plane After = Plane::template Forward<Dx, Dy>(A[4]);
+                Bound = Plane::AndNot(Plane::AndNot(Bound, Plane::template Backward<Dx, Dy>(P)), After);
+            }
+            Plane Result{};
+            for (int j = 4; j >= 0; --j)
+            {
+                Plane Window = F[j] & Bound;
+                for (int i = 0; i < 5; ++i)
+                {
+                    if (i != j) { Window = Window & A[i]; }
+                }
+                Result = Plane::template Backward<Dx, Dy>(Result) | Window;
+            }
+            return Result;
+        };
+#pragma endregion
+    };
+}
@@ -0,0 +1,242 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Agents.h"
+#include "Archive.h"
+#include "Notation.h"
+#include "OpeningBook.h"
+#include "Scheduler.h"
+namespace Gomoku
+{
+    class Book
+    {
+    private:
+        struct Game
+        {
+        public:
+            std::vector<Position> Moves;
+            Result Re;
+        };
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            if (argc >= 3 && std::strcmp(argv[1], "build") == 0) { return Build(argc, argv); }
+            if (argc >= 3 && std::strcmp(argv[1], "probe") == 0) { return Probe(argc, argv); }
+            if (argc == 3 && std::strcmp(argv[1], "bench") == 0) { return Bench(argv[2]); }
+            std::fprintf(stderr, "usage: %s build [--plies N] [--min N] [--archive file]... [--selfplay N] [--agent SPEC] [--random N] [--seed N] [--threads N] book\n", argv[0]);
+            std::fprintf(stderr, "       %s probe book [moves...]\n", argv[0]);
+            std::fprintf(stderr, "       %s bench book\n", argv[0]);
+            return 1;
+        };
+    private:
+        static int Build(int argc, char* argv[])
+        {
+            int Plies = 12;
+            std::uint32_t MinGames = 4u;
+            std::vector<const char*> Archives{};
+            long SelfPlay = 0;
+            std::string Spec = "engine:20";
+            int Random = 2;
+            std::uint64_t Seed = 1u;
+            unsigned Threads = 0u;
+            const char* Path = nullptr;
+            for (int i = 2; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--plies") == 0 && i + 1 < argc) { Plies = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--min") == 0 && i + 1 < argc) { MinGames = static_cast<std::uint32_t>(std::atol(argv[++i])); }
+                else if (std::strcmp(argv[i], "--archive") == 0 && i + 1 < argc) { Archives.push_back(argv[++i]); }
+                else if (std::strcmp(argv[i], "--selfplay") == 0 && i + 1 < argc) { SelfPlay = std::atol(argv[++i]); }
+                else if (std::strcmp(argv[i], "--agent") == 0 && i + 1 < argc) { Spec = argv[++i]; }
+                else if (std::strcmp(argv[i], "--random") == 0 && i + 1 < argc) { Random = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) { Seed = std::strtoull(argv[++i], nullptr, 10); }
+                else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { Threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+                else if (argv[i][0] != '-' && Path == nullptr) { Path = argv[i]; }
+                else { return Main(1, argv); }
+            }
+            if (Path == nullptr || Agent::Make(Spec, 0u) == nullptr) { return Main(1, argv); }
+            // The centre and the random moves after it all fall on the 25 points within 2 boxes of the centre.
+            Random = std::clamp(Random, 0, 24);
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            OpeningBook::Builder Bu{ Plies };
+            std::uint64_t Games = 0u;
+            std::vector<Position> Moves{};
+            for (const char* Source : Archives)
+            {
+                Archive Ar{ Source };
+                if (!Ar.Valid())
+                {
+                    std::fprintf(stderr, "%s is not an archive\n", Source);
+                    return 1;
+                }
+                for (Archive::Game Ga : Ar)
+                {
+                    Moves.clear();
+                    for (int i = 0; i < Ga.Count; ++i) { Moves.push_back(Ga[i]); }
+                    Bu.Add(Moves.data(), Ga.Count, Ga.Re);
+                    ++Games;
+                }
+            }
+            if (SelfPlay > 0)
+            {
+                std::vector<Game> Played(static_cast<std::size_t>(SelfPlay));
+                Scheduler Sc{ Threads };
+                Sc.ParallelFor(Played.size(), 1u, [&](std::size_t i, unsigned)
+                {
+                    std::uint64_t Salt = Seed * 0x9E3779B97F4A7C15ull + i;
+                    std::unique_ptr<Agent> Ag = Agent::Make(Spec, Salt);
+                    Played[i] = Play(*Ag, Random, Salt);
+                });
+                for (const Game& Ga : Played)
+                {
+                    Bu.Add(Ga.Moves.data(), static_cast<int>(Ga.Moves.size()), Ga.Re);
+                    ++Games;
+                }
+            }
+            long Entries = Bu.Write(Path, MinGames);
+            if (Entries < 0)
+            {
+                std::fprintf(stderr, "cannot write %s\n", Path);
+                return 1;
+            }
+            std::fprintf(stderr, "games %llu, positions %zu, entries %ld, %.3f s\n", static_cast<unsigned long long>(Games), Bu.Positions(), Entries,
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - Begin).count());
+            return 0;
+        };
+        // Plays a game of Ag against itself after the center and Random moves at random within 2 boxes of it.
+        static Game Play(Agent& Ag, int Random, std::uint64_t Seed)
+        {
+            Game Ga{ {}, Result::None };
+            std::mt19937_64 Rng{ Seed };
+            Board Bo{};
+            Referee Rf{ Bo };
+            while (Ga.Re == Result::None)
+            {
+                Position Po = Position::Null;
+                if (Bo.IsPending()) { Po = Position{ 7, 7 }; }
+                else if (Bo.Rounds() <= Random)
+                {
+                    while (Po == Position::Null)
+                    {
+                        Position Pick{ 5 + static_cast<int>(Rng() % 5u), 5 + static_cast<int>(Rng() % 5u) };
+                        if (Bo.CanPutChess(Pick)) { Po = Pick; }
+                    }
+                }
+                else { Po = Ag.Move(Bo); }
+                if (!Bo.CanPutChess(Po))
+                {
+                    Ga.Re = Bo.IsBlackTurn() ? Result::Lost : Result::Won;
+                    break;
+                }
+                Ga.Moves.push_back(Po);
+                Ga.Re = Rf.PutChess(Po).Re;
+            }
+            return Ga;
+        };
+        static int Probe(int argc, char* argv[])
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            OpeningBook Ob{ argv[2] };
+            double Load = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Begin).count();
+            std::string Record{};
+            for (int i = 3; i < argc; ++i)
+            {
+                Record += argv[i];
+                Record += ' ';
+            }
+            std::vector<Position> Moves{};
+            Board Bo{};
+            Referee Rf{ Bo };
+            if (!Notation::ParseGame(Record, Moves))
+            {
+                std::fprintf(stderr, "cannot parse the record after %zu moves\n", Moves.size());
+                return 1;
+            }
+            for (Position Po : Moves)
+            {
+                if (!Bo.CanPutChess(Po) || Rf.PutChess(Po).Re != Result::None)
+                {
+                    std::fprintf(stderr, "the record is illegal or already decided at %s\n", Notation::Format(Po).c_str());
+                    return 1;
+                }
+            }
+            OpeningBook::Entry En{};
+            Position Po = Ob.Probe(Bo, En);
+            std::printf("%s\n", Notation::Format(Po).c_str());
+            if (Po != Position::Null) { std::fprintf(stderr, "games %u, score %.3f, ", En.Games, En.Score()); }
+            std::fprintf(stderr, "entries %zu, loaded in %.3f ms\n", Ob.Size(), Load);
+            return 0;
+        };
+        // Loads the book and finds each of its entries, and as many random keys, in lookups per second.
+        static int Bench(const char* Path)
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            OpeningBook Ob{ Path };
+            double Load = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Begin).count();
+            if (Ob.Size() == 0u)
+            {
+                std::fprintf(stderr, "%s is not a book or is empty\n", Path);
+                return 1;
+            }
+            std::vector<std::uint64_t> Keys{};
+            std::mt19937_64 Rng{ 1u };
+            for (std::size_t i = 0; i < Ob.Size(); ++i)
+            {
+                Keys.push_back(Ob.Key(i));
+                Keys.push_back(Rng());
+            }
+            std::shuffle(Keys.begin(), Keys.end(), Rng);
+            std::uint64_t Found = 0u;
+            std::size_t Lookups = 0u;
+            OpeningBook::Entry En{};
+            Begin = std::chrono::steady_clock::now();
+            for (int Round = 0; Round < 16 || Lookups < (1u << 22); ++Round)
+            {
+                for (std::uint64_t Key : Keys) { Found += Ob.Find(Key, En); }
+                Lookups += Keys.size();
+            }
+            double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Begin).count();
+            std::fprintf(stderr, "entries %zu, loaded in %.3f ms, lookups %zu, found %llu, %.0f lookups/s\n", Ob.Size(), Load, Lookups,
+                static_cast<unsigned long long>(Found), Lookups / (Seconds > 0 ? Seconds : 1e-9));
+            return Found * 2u == Lookups ? 0 : 2;
+        };
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Book::Main(argc, argv);
+};
@@ -0,0 +1,171 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Archive.h"
+#include "Notation.h"
+#include "Png.h"
+#include "Renderer.h"
+#include "Scheduler.h"
+namespace Gomoku
+{
+    class Diagram
+    {
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            std::vector<const char*> Archives{};
+            std::vector<const char*> Records{};
+            const char* Out = nullptr;
+            unsigned Threads = 0u;
+            int Padding = 12;
+            int Line = 1;
+            int Grid = 8;
+            int Limit = 0;
+            for (int i = 1; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--archive") == 0 && i + 1 < argc) { Archives.push_back(argv[++i]); }
+                else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) { Out = argv[++i]; }
+                else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { Threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+                else if (std::strcmp(argv[i], "--padding") == 0 && i + 1 < argc) { Padding = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--line") == 0 && i + 1 < argc) { Line = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--grid") == 0 && i + 1 < argc) { Grid = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--moves") == 0 && i + 1 < argc) { Limit = std::atoi(argv[++i]); }
+                else if (argv[i][0] != '-') { Records.push_back(argv[i]); }
+                else { return Usage(argv[0]); }
+            }
+            Layout La{};
+            if (!La.SetParams(Padding, Line, Grid))
+            {
+                std::fprintf(stderr, "the line shall be thinner than the grid, and the grid smaller than the padding\n");
+                return 1;
+            }
+            if (Archives.empty() && Records.empty()) { return Usage(argv[0]); }
+            std::vector<Position> Moves{};
+            std::vector<std::size_t> Offsets{ 0u };
+            for (const char* Source : Archives)
+            {
+                Archive Ar{ Source };
+                if (!Ar.Valid())
+                {
+                    std::fprintf(stderr, "%s is not an archive\n", Source);
+                    return 1;
+                }
+                for (Archive::Game Ga : Ar)
+                {
+                    for (int i = 0; i < Ga.Count; ++i) { Moves.push_back(Ga[i]); }
+                    Offsets.push_back(Moves.size());
+                }
+            }
+            std::vector<Position> Parsed{};
+            for (const char* Source : Records)
+            {
+                std::ifstream File{ Source };
+                if (!File)
+                {
+                    std::fprintf(stderr, "cannot open %s\n", Source);
+                    return 1;
+                }
+                std::string Text{};
+                while (std::getline(File, Text))
+                {
+                    Notation::ParseGame(Text, Parsed);
+                    Moves.insert(Moves.end(), Parsed.begin(), Parsed.end());
+                    Offsets.push_back(Moves.size());
+                }
+            }
+            if (Out != nullptr)
+            {
+                std::error_code Error{};
+                std::filesystem::create_directories(Out, Error);
+            }
+            Scheduler Sc{ Threads };
+            std::vector<BoardRenderer> Renderers{};
+            std::vector<Png> Encoders(Sc.Threads());
+            for (unsigned i = 0; i < Sc.Threads(); ++i)
+            {
+                Renderers.emplace_back(std::make_unique<Bitmap>(0, 0));
+                Renderers.back().Prepare(La);
+            }
+            std::size_t Games = Offsets.size() - 1u;
+            std::atomic<std::uint64_t> Bytes{ 0u };
+            std::atomic<std::uint64_t> Failed{ 0u };
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            Sc.ParallelFor(Games, 16u, [&](std::size_t i, unsigned Worker)
+            {
+                BoardRenderer& Rd = Renderers[Worker];
+                Board Bo{};
+                std::size_t End = Limit > 0 ? std::min(Offsets[i + 1u], Offsets[i] + static_cast<std::size_t>(Limit)) : Offsets[i + 1u];
+                for (std::size_t k = Offsets[i]; k < End && Bo.CanPutChess(Moves[k]); ++k)
+                {
+                    Bo[Moves[k]] = Bo.IsBlackTurn() ? Chess::Black : Chess::White;
+                    ++Bo;
+                }
+                Rd.RenderClient(Bo);
+                Rd.TakeDirty();
+                const std::vector<std::uint8_t>& File = Encoders[Worker].Encode(static_cast<const Bitmap&>(Rd.Buffer()));
+                Bytes.fetch_add(File.size(), std::memory_order_relaxed);
+                if (Out == nullptr) { return; }
+                char Name[24];
+                std::snprintf(Name, sizeof(Name), "%08zu.png", i);
+                if (!Png::Write((std::filesystem::path{ Out } / Name).string(), File)) { Failed.fetch_add(1u, std::memory_order_relaxed); }
+            });
+            double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Begin).count();
+            if (Seconds <= 0) { Seconds = 1e-9; }
+            std::fprintf(stderr, "threads %u, positions %zu, %d by %d, %.0f bytes each, %.3f s, %.0f positions/s\n", Sc.Threads(), Games,
+                La.BoardOuterSize(), La.BoardOuterSize(), Games > 0u ? Bytes.load() / static_cast<double>(Games) : 0e0, Seconds, Games / Seconds);
+            if (Failed.load() != 0u)
+            {
+                std::fprintf(stderr, "cannot write %llu of them to %s\n", static_cast<unsigned long long>(Failed.load()), Out);
+                return 1;
+            }
+            return 0;
+        };
+    private:
+        static int Usage(const char* Name)
+        {
+            std::fprintf(stderr, "usage: %s [--archive file]... [--out dir] [--threads N] [--padding N] [--line N] [--grid N] [--moves N] [records.txt]...\n", Name);
+            return 1;
+        };
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Diagram::Main(argc, argv);
+};
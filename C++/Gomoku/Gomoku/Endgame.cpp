@@ -0,0 +1,223 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Archive.h"
+#include "EndgameTable.h"
+#include "Notation.h"
+#include "Scheduler.h"
+namespace Gomoku
+{
+    class Endgame
+    {
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            if (argc >= 3 && std::strcmp(argv[1], "build") == 0) { return Build(argc, argv); }
+            if (argc >= 3 && std::strcmp(argv[1], "probe") == 0) { return Probe(argc, argv); }
+            if (argc == 3 && std::strcmp(argv[1], "bench") == 0) { return Bench(argv[2]); }
+            std::fprintf(stderr, "usage: %s build [--archive file]... [--records file]... [--stones N] [--last N] [--depth N] [--nodes N] [--threads N] table\n", argv[0]);
+            std::fprintf(stderr, "       %s probe table [moves...]\n", argv[0]);
+            std::fprintf(stderr, "       %s bench table\n", argv[0]);
+            return 1;
+        };
+    private:
+        static int Build(int argc, char* argv[])
+        {
+            std::vector<const char*> Archives{};
+            std::vector<const char*> Records{};
+            int Stones = 40;
+            int Last = 8;
+            int Depth = 8;
+            long Nodes = 1l << 18;
+            unsigned Threads = 0u;
+            const char* Path = nullptr;
+            for (int i = 2; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--archive") == 0 && i + 1 < argc) { Archives.push_back(argv[++i]); }
+                else if (std::strcmp(argv[i], "--records") == 0 && i + 1 < argc) { Records.push_back(argv[++i]); }
+                else if (std::strcmp(argv[i], "--stones") == 0 && i + 1 < argc) { Stones = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--last") == 0 && i + 1 < argc) { Last = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) { Depth = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--nodes") == 0 && i + 1 < argc) { Nodes = std::atol(argv[++i]); }
+                else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { Threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+                else if (argv[i][0] != '-' && Path == nullptr) { Path = argv[i]; }
+                else { return Main(1, argv); }
+            }
+            if (Path == nullptr || Nodes <= 0) { return Main(1, argv); }
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            EndgameTable::Builder Bu{};
+            std::uint64_t Games = 0u;
+            std::vector<Position> Moves{};
+            for (const char* Source : Archives)
+            {
+                Archive Ar{ Source };
+                if (!Ar.Valid())
+                {
+                    std::fprintf(stderr, "%s is not an archive\n", Source);
+                    return 1;
+                }
+                for (Archive::Game Ga : Ar)
+                {
+                    Moves.clear();
+                    for (int i = 0; i < Ga.Count; ++i) { Moves.push_back(Ga[i]); }
+                    Collect(Bu, Moves, Stones, Last);
+                    ++Games;
+                }
+            }
+            for (const char* Source : Records)
+            {
+                std::ifstream File{ Source };
+                if (!File)
+                {
+                    std::fprintf(stderr, "cannot open %s\n", Source);
+                    return 1;
+                }
+                std::string Line{};
+                while (std::getline(File, Line))
+                {
+                    if (!Notation::ParseGame(Line, Moves)) { continue; }
+                    Collect(Bu, Moves, Stones, Last);
+                    ++Games;
+                }
+            }
+            std::size_t Positions = Bu.Positions();
+            Scheduler Sc{ Threads };
+            std::chrono::steady_clock::time_point Proving = std::chrono::steady_clock::now();
+            std::size_t Proven = Bu.Prove(Sc, Depth, static_cast<std::size_t>(Nodes));
+            double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Proving).count();
+            long Entries = Bu.Write(Path);
+            if (Entries < 0)
+            {
+                std::fprintf(stderr, "cannot write %s\n", Path);
+                return 1;
+            }
+            std::fprintf(stderr, "threads %u, games %llu, positions %zu, proven %zu, entries %ld, nodes %llu, %.0f nodes/s, %.3f s\n", Sc.Threads(),
+                static_cast<unsigned long long>(Games), Positions, Proven, Entries, static_cast<unsigned long long>(Bu.Searched()),
+                Bu.Searched() / (Seconds > 0 ? Seconds : 1e-9), std::chrono::duration<double>(std::chrono::steady_clock::now() - Begin).count());
+            return 0;
+        };
+        // Adds the Boards of the Last plies before the end of a game, or before its decisive move, which have no
+        // more than Stones Chesses.
+        static void Collect(EndgameTable::Builder& Bu, const std::vector<Position>& Moves, int Stones, int Last)
+        {
+            Board Bo{};
+            Referee Rf{ Bo };
+            std::vector<Board> Boards{};
+            bool Open = true;
+            for (std::size_t i = 0; i <= Moves.size() && Open && Bo.Rounds() <= Stones; ++i)
+            {
+                Boards.push_back(Bo);
+                Open = i < Moves.size() && Bo.CanPutChess(Moves[i]) && Rf.PutChess(Moves[i]).Re == Result::None;
+            }
+            for (std::size_t i = Boards.size() - std::min(Boards.size(), static_cast<std::size_t>(std::max(Last, 0))); i < Boards.size(); ++i) { Bu.Add(Boards[i]); }
+        };
+        static int Probe(int argc, char* argv[])
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            EndgameTable Et{ argv[2] };
+            double Load = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Begin).count();
+            std::string Record{};
+            for (int i = 3; i < argc; ++i)
+            {
+                Record += argv[i];
+                Record += ' ';
+            }
+            std::vector<Position> Moves{};
+            Board Bo{};
+            Referee Rf{ Bo };
+            if (!Notation::ParseGame(Record, Moves))
+            {
+                std::fprintf(stderr, "cannot parse the record after %zu moves\n", Moves.size());
+                return 1;
+            }
+            for (Position Po : Moves)
+            {
+                if (!Bo.CanPutChess(Po) || Rf.PutChess(Po).Re != Result::None)
+                {
+                    std::fprintf(stderr, "the record is illegal or already decided at %s\n", Notation::Format(Po).c_str());
+                    return 1;
+                }
+            }
+            Position Move = Position::Null;
+            int Length = 0;
+            ProofSearch::Outcome Ou = Et.Probe(Bo, Move, Length);
+            static constexpr const char* Names[3]{ "unknown", "win", "loss" };
+            std::printf("%s %s\n", Names[static_cast<int>(Ou)], Notation::Format(Move).c_str());
+            if (Ou != ProofSearch::Outcome::Unknown) { std::fprintf(stderr, "in %d moves, ", Length); }
+            std::fprintf(stderr, "entries %zu, loaded in %.3f ms\n", Et.Size(), Load);
+            return 0;
+        };
+        // Loads the table and finds each of its entries, and as many random keys, in lookups per second.
+        static int Bench(const char* Path)
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            EndgameTable Et{ Path };
+            double Load = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Begin).count();
+            if (Et.Size() == 0u)
+            {
+                std::fprintf(stderr, "%s is not a table or is empty\n", Path);
+                return 1;
+            }
+            std::vector<std::uint64_t> Keys{};
+            std::mt19937_64 Rng{ 1u };
+            for (std::size_t i = 0; i < Et.Size(); ++i)
+            {
+                Keys.push_back(Et.Key(i));
+                Keys.push_back(Rng());
+            }
+            std::shuffle(Keys.begin(), Keys.end(), Rng);
+            std::uint64_t Found = 0u;
+            std::size_t Lookups = 0u;
+            EndgameTable::Entry En{};
+            Begin = std::chrono::steady_clock::now();
+            for (int Round = 0; Round < 16 || Lookups < (1u << 22); ++Round)
+            {
+                for (std::uint64_t Key : Keys) { Found += Et.Find(Key, En); }
+                Lookups += Keys.size();
+            }
+            double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Begin).count();
+            std::fprintf(stderr, "entries %zu, %.1f bytes each, loaded in %.3f ms, lookups %zu, found %llu, %.0f lookups/s\n", Et.Size(),
+                Et.Bytes() / static_cast<double>(Et.Size()), Load, Lookups, static_cast<unsigned long long>(Found), Lookups / (Seconds > 0 ? Seconds : 1e-9));
+            return Found * 2u == Lookups ? 0 : 2;
+        };
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Endgame::Main(argc, argv);
+};
@@ -0,0 +1,259 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "ProofSearch.h"
+#include "Referee.h"
+#include "Scheduler.h"
+#include "TranspositionTable.h"
+namespace Gomoku
+{
+    // A table is the 8 bytes of Magic, the number of entries and the number of Bits of the directory as 4 bytes
+    // each, the directory of 2 to the Bits plus 1 offsets of 4 bytes, and the entries sorted by the canonical
+    // hash of their Board, 8 bytes each. The leading Bits of a hash are kept by the directory only, so that an
+    // entry holds the last 48 bits of the hash, the move in the transform of the Symmetry.Canonical, and the
+    // Outcome with the Length of the win, and a slot of the directory serves about 4 entries. Every number is
+    // little endian.
+    class EndgameTable
+    {
+#pragma region constants
+    public:
+        static constexpr const char Magic[8]{ 'G', 'o', 'm', 'o', 'E', 'n', 'd', 's' };
+    private:
+        static constexpr const std::uint64_t Low = 0xFFFFFFFFFFFFull;
+#pragma endregion
+#pragma region helper-classes
+    public:
+        struct Entry
+        {
+        public:
+            std::uint64_t Key;
+            ProofSearch::Outcome Ou;
+            std::uint8_t Move;
+            std::uint8_t Length;
+            constexpr Entry()
+                : Key{ 0u }, Ou{ ProofSearch::Outcome::Unknown }, Move{ Byte }, Length{ 0u }
+            {};
+            constexpr std::uint64_t Pack() const &
+            {
+                return (Key & Low) | static_cast<std::uint64_t>(Move) << 48 | static_cast<std::uint64_t>(Ou) << 56 | static_cast<std::uint64_t>(Length & 0x3Fu) << 58;
+            };
+        };
+        // Proves the Boards given by a Scheduler, one ProofSearch for each of its threads, and keeps each proven
+        // Board once by its canonical hash.
+        class Builder
+        {
+        private:
+            std::vector<Board> Boards;
+            std::vector<Entry> Entries;
+            std::uint64_t Nodes;
+        public:
+            Builder()
+                : Boards{}, Entries{}, Nodes{ 0u }
+            {};
+            void Add(const Board& Bo) &
+            {
+                if (!Bo.IsPending() && !Bo.IsEnded()) { Boards.push_back(Bo); }
+            };
+            std::size_t Positions() const &
+            {
+                return Boards.size();
+            };
+            std::uint64_t Searched() const &
+            {
+                return Nodes;
+            };
+            // Solves every distinct Board added so far to Depth moves of the winner with Capacity nodes for each
+            // search, returning the number of wins and losses proven.
+            std::size_t Prove(Scheduler& Sc, int Depth, std::size_t Capacity) &
+            {
+                std::vector<Entry> Found(Boards.size());
+                std::vector<int> Transforms(Boards.size(), 0);
+                for (std::size_t i = 0; i < Boards.size(); ++i) { Found[i].Key = Symmetry::Canonical(Boards[i], Transforms[i]); }
+                std::vector<std::size_t> Order(Boards.size());
+                for (std::size_t i = 0; i < Order.size(); ++i) { Order[i] = i; }
+                std::sort(Order.begin(), Order.end(), [&](std::size_t L, std::size_t R) { return Found[L].Key < Found[R].Key; });
+                Order.erase(std::unique(Order.begin(), Order.end(), [&](std::size_t L, std::size_t R) { return Found[L].Key == Found[R].Key; }), Order.end());
+                std::vector<std::unique_ptr<ProofSearch>> Searches{};
+                for (unsigned i = 0; i < Sc.Threads(); ++i) { Searches.emplace_back(std::make_unique<ProofSearch>(Capacity)); }
+                std::vector<std::uint64_t> Spent(Sc.Threads(), 0u);
+                Sc.ParallelFor(Order.size(), 1u, [&](std::size_t i, unsigned Worker)
+                {
+                    std::size_t At = Order[i];
+                    Position Move = Position::Null;
+                    int Length = 0;
+                    Entry& En = Found[At];
+                    En.Ou = Searches[Worker]->Solve(Boards[At], Depth, Move, Length);
+                    En.Move = Move == Position::Null ? Byte : static_cast<std::uint8_t>(Symmetry::Apply(Move, Transforms[At]));
+                    En.Length = static_cast<std::uint8_t>(Length);
+                    Spent[Worker] += Searches[Worker]->LastStats().Nodes;
+                });
+                std::size_t Proven = 0u;
+                for (std::size_t At : Order)
+                {
+                    if (Found[At].Ou == ProofSearch::Outcome::Unknown) { continue; }
+                    Entries.push_back(Found[At]);
+                    ++Proven;
+                }
+                for (std::uint64_t Count : Spent) { Nodes += Count; }
+                Boards.clear();
+                return Proven;
+            };
+            // Writes the table, returning the number of entries or -1 when the file cannot be written.
+            long Write(const std::string& Path) &
+            {
+                std::sort(Entries.begin(), Entries.end(), [](const Entry& L, const Entry& R) { return L.Key < R.Key; });
+                Entries.erase(std::unique(Entries.begin(), Entries.end(), [](const Entry& L, const Entry& R) { return L.Key == R.Key; }), Entries.end());
+                std::uint32_t Bits = 0u;
+                while ((std::size_t{ 4 } << Bits) < Entries.size()) { ++Bits; }
+                std::vector<std::uint32_t> Directory((std::size_t{ 1 } << Bits) + 1u, 0u);
+                for (const Entry& En : Entries) { ++Directory[Bucket(En.Key, Bits) + 1u]; }
+                for (std::size_t i = 1; i < Directory.size(); ++i) { Directory[i] += Directory[i - 1]; }
+                std::ofstream File{ Path, std::ios::binary | std::ios::trunc };
+                File.write(Magic, sizeof(Magic));
+                Put(File, static_cast<std::uint32_t>(Entries.size()));
+                Put(File, Bits);
+                for (std::uint32_t Offset : Directory) { Put(File, Offset); }
+                for (const Entry& En : Entries) { Put(File, En.Pack()); }
+                return File ? static_cast<long>(Entries.size()) : -1;
+            };
+        private:
+            template <typename T>
+            static void Put(std::ofstream& File, T Value)
+            {
+                char Bytes[sizeof(T)]{};
+                for (std::size_t i = 0; i < sizeof(T); ++i) { Bytes[i] = static_cast<char>((static_cast<std::uint64_t>(Value) >> (i * 8)) & Byte); }
+                File.write(Bytes, sizeof(T));
+            };
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        MappedFile Ma;
+        const std::uint8_t* Directory;
+        const std::uint8_t* Entries;
+        std::uint32_t Count;
+        std::uint32_t Bits;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        // Maps the table, which is left empty when the file is not a whole table.
+        explicit EndgameTable(const std::string& Path)
+            : Ma{ Path }, Directory{ nullptr }, Entries{ nullptr }, Count{ 0u }, Bits{ 0u }
+        {
+            const std::uint8_t* Data = Ma.Data();
+            if (Ma.Size() < sizeof(Magic) + 8u || std::memcmp(Data, Magic, sizeof(Magic)) != 0) { return; }
+            std::uint32_t Number = Get<std::uint32_t>(Data + 8);
+            std::uint32_t Width = Get<std::uint32_t>(Data + 12);
+            if (Width > 31u) { return; }
+            std::size_t Offsets = (std::size_t{ 1 } << Width) + 1u;
+            if (Ma.Size() != 16u + Offsets * 4u + static_cast<std::size_t>(Number) * 8u) { return; }
+            Directory = Data + 16;
+            Entries = Directory + Offsets * 4u;
+            Count = Number;
+            Bits = Width;
+        };
+        std::size_t Size() const &
+        {
+            return Count;
+        };
+        std::size_t Bytes() const &
+        {
+            return Ma.Size();
+        };
+        // Finds Key by its leading Bits and last 48 bits, where the Key of En is given back as asked.
+        bool Find(std::uint64_t Key, Entry& En) const &
+        {
+            if (Count == 0u) { return false; }
+            std::size_t Slot = Bucket(Key, Bits);
+            std::uint32_t First = Get<std::uint32_t>(Directory + Slot * 4u);
+            std::uint32_t Last = std::min(Get<std::uint32_t>(Directory + Slot * 4u + 4u), Count);
+            for (std::uint32_t i = First; i < Last; ++i)
+            {
+                std::uint64_t Packed = Get<std::uint64_t>(Entries + static_cast<std::size_t>(i) * 8u);
+                if ((Packed & Low) != (Key & Low)) { continue; }
+                En.Key = Key;
+                En.Move = static_cast<std::uint8_t>(Packed >> 48);
+                En.Ou = static_cast<ProofSearch::Outcome>((Packed >> 56) & 0x3u);
+                En.Length = static_cast<std::uint8_t>(Packed >> 58);
+                return true;
+            }
+            return false;
+        };
+        // Returns the Outcome for the side to move of Bo, with the winning move mapped back from the canonical
+        // transform and the moves of the winner up to its five, or Outcome.Unknown when Bo is not in the table.
+        ProofSearch::Outcome Probe(const Board& Bo, Position& Move, int& Length) const &
+        {
+            Entry En{};
+            int Tr = 0;
+            Move = Position::Null;
+            Length = 0;
+            if (!Find(Symmetry::Canonical(Bo, Tr), En)) { return ProofSearch::Outcome::Unknown; }
+            if (En.Move != Byte) { Move = Symmetry::Apply(Position{ En.Move }, Symmetry::Inverse(Tr)); }
+            Length = En.Length;
+            return En.Ou;
+        };
+        // The key of the I-th entry with the bits kept by neither the directory nor the entry left 0, which the
+        // Find takes as the same key, for walking the table in order.
+        std::uint64_t Key(std::size_t I) const &
+        {
+            std::size_t First = 0u;
+            std::size_t Last = std::size_t{ 1 } << Bits;
+            while (Last - First > 1u)
+            {
+                std::size_t Middle = (First + Last) / 2u;
+                if (Get<std::uint32_t>(Directory + Middle * 4u) <= I) { First = Middle; }
+                else { Last = Middle; }
+            }
+            std::uint64_t Leading = Bits == 0u ? 0u : static_cast<std::uint64_t>(First) << (64u - Bits);
+            return Leading | (Get<std::uint64_t>(Entries + I * 8u) & Low);
+        };
+    private:
+        static constexpr std::size_t Bucket(std::uint64_t Key, std::uint32_t Bits)
+        {
+            return Bits == 0u ? 0u : static_cast<std::size_t>(Key >> (64u - Bits));
+        };
+        template <typename T>
+        static T Get(const std::uint8_t* At)
+        {
+            std::uint64_t Value = 0u;
+            for (std::size_t i = 0; i < sizeof(T); ++i) { Value |= static_cast<std::uint64_t>(At[i]) << (i * 8); }
+            return static_cast<T>(Value);
+        };
+#pragma endregion
+    };
+}
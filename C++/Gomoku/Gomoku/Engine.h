@@ -0,0 +1,249 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "EndgameTable.h"
+#include "Evaluator.h"
+#include "MoveGenerator.h"
+#include "Referee.h"
+#include "TranspositionTable.h"
+namespace Gomoku
+{
+    class Engine
+    {
+#pragma region constants
+    public:
+        static constexpr const int Win = 1000000;
+        static constexpr const int Width = 12;
+        // The plies from the root where the Tt is keyed by the Symmetry.Canonical, which costs a pass over the
+        // Board but shares the entry with the 7 other transforms of the position.
+        static constexpr const int Symmetric = 2;
+#pragma endregion
+#pragma region helper-classes
+    public:
+        struct Stats
+        {
+        public:
+            Position Best;
+            int Score;
+            int Depth;
+            std::uint64_t Nodes;
+            std::uint64_t Hits;
+            std::chrono::nanoseconds Elapsed;
+            constexpr Stats()
+                : Best{ Position::Null }, Score{ 0 }, Depth{ 0 }, Nodes{ 0u }, Hits{ 0u }, Elapsed{ 0 }
+            {};
+            constexpr double NodesPerSecond() const &
+            {
+                return Elapsed.count() > 0 ? Nodes * 1e9 / Elapsed.count() : 0e0;
+            };
+        };
+        using Candidates = MoveGenerator::Buffer;
+#pragma endregion
+#pragma region fields
+    private:
+        Stats St;
+        // The root, which each node puts its move on and takes it off again.
+        LineBoard Bo;
+        // The Evaluator of Bo, which each node updates with its move and undoes again.
+        Evaluator Ev;
+        std::chrono::steady_clock::time_point Deadline;
+        bool Stopped;
+        TranspositionTable* Tt;
+        const std::atomic<bool>* Abort;
+        int Skew;
+        const EndgameTable* Et;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        // An Engine given Abort is one of several sharing Tt, which the owner of Abort starts a new search on,
+        // and it starts deepening from 1 + Skew so that the Engines sharing Tt do not walk in step.
+        explicit Engine(TranspositionTable* Tt = nullptr, const std::atomic<bool>* Abort = nullptr, int Skew = 0)
+            : St{}, Bo{}, Ev{ Board{} }, Deadline{}, Stopped{ false }, Tt{ Tt }, Abort{ Abort }, Skew{ Skew }, Et{ nullptr }
+        {};
+        // Takes the proven results of Et at the root and the 2 plies below it, where a lookup costs more than a
+        // node; nullptr stops consulting.
+        void Consult(const EndgameTable* Et) &
+        {
+            this->Et = Et;
+        };
+        const Stats& LastStats() const &
+        {
+            return St;
+        };
+        Position BestMove(const Board& Root, std::chrono::milliseconds Budget, int Limit = 225) &
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            St = Stats{};
+            Deadline = Begin + Budget;
+            Stopped = false;
+            if (Tt != nullptr && Abort == nullptr) { Tt->NewSearch(); }
+            Bo = LineBoard{ Root };
+            Ev = Evaluator{ Root };
+            Candidates Moves{};
+            int Count = Generate(Bo, Moves);
+            Position Proven = Position::Null;
+            int Length = 0;
+            if (Et != nullptr && Et->Probe(Root, Proven, Length) == ProofSearch::Outcome::Win && Proven != Position::Null)
+            {
+                St.Best = Proven;
+                St.Score = Win - (2 * Length - 2);
+            }
+            else if (Count > 0)
+            {
+                St.Best = Moves[0].Po;
+                for (int Depth = 1 + Skew; Depth <= Limit && !Stopped; ++Depth)
+                {
+                    Position Best = Position::Null;
+                    int Score = Search(Depth, -Win - 1, Win + 1, 0, &Best);
+                    if (Stopped) { break; }
+                    if (Best != Position::Null)
+                    {
+                        St.Best = Best;
+                        St.Score = Score;
+                    }
+                    St.Depth = Depth;
+                    if (Score >= Win - 225 || Score <= -Win + 225) { break; }
+                }
+            }
+            St.Elapsed = std::chrono::steady_clock::now() - Begin;
+            return St.Best;
+        };
+        template <typename B>
+        static int Generate(B& Bo, Candidates& Moves)
+        {
+            return MoveGenerator::Generate(Bo, Moves);
+        };
+    private:
+        bool Expired() &
+        {
+            if (Abort != nullptr && Abort->load(std::memory_order_relaxed)) { Stopped = true; }
+            if ((St.Nodes & 1023u) == 0u && std::chrono::steady_clock::now() >= Deadline) { Stopped = true; }
+            return Stopped;
+        };
+        // Scores within 225 of Win are mates; the table keeps them relative to the stored node.
+        static constexpr int ToTable(int Score, int Ply)
+        {
+            if (Score >= Win - 225) { return Score + Ply; }
+            if (Score <= -Win + 225) { return Score - Ply; }
+            return Score;
+        };
+        static constexpr int FromTable(int Score, int Ply)
+        {
+            if (Score >= Win - 225) { return Score - Ply; }
+            if (Score <= -Win + 225) { return Score + Ply; }
+            return Score;
+        };
+        // The MoveGenerator leaves out the points forbidden to Black and rates a five as Threat::Win, so a move
+        // is put without the Referee, and a five scores without being put at all.
+        int Search(int Depth, int Alpha, int Beta, int Ply, Position* Best) &
+        {
+            if (Et != nullptr && Ply > 0 && Ply <= 2)
+            {
+                Position Proven = Position::Null;
+                int Length = 0;
+                ProofSearch::Outcome Ou = Et->Probe(Bo.Plain(), Proven, Length);
+                if (Ou == ProofSearch::Outcome::Win) { return Win - (Ply + 2 * Length - 2); }
+                if (Ou == ProofSearch::Outcome::Loss) { return -(Win - (Ply + 2 * Length - 1)); }
+            }
+            TranspositionTable::Entry En{};
+            bool Hit = Tt != nullptr && (Ply <= Symmetric ? Tt->ProbeSymmetric(Bo.Plain(), En) : Tt->Probe(Bo.Hash(), En));
+            if (Hit)
+            {
+                ++St.Hits;
+                int Value = FromTable(En.Score, Ply);
+                if (Ply > 0 && En.Depth >= Depth)
+                {
+                    if (En.Bo == TranspositionTable::Bound::Exact) { return Value; }
+                    if (En.Bo == TranspositionTable::Bound::Lower && Value >= Beta) { return Value; }
+                    if (En.Bo == TranspositionTable::Bound::Upper && Value <= Alpha) { return Value; }
+                }
+            }
+            Candidates Moves{};
+            int Count = Generate(Bo, Moves);
+            if (Hit && En.Move != Position::Null)
+            {
+                for (int i = 1; i < Count; ++i)
+                {
+                    if (Moves[i].Po != En.Move) { continue; }
+                    std::rotate(Moves.begin(), Moves.begin() + i, Moves.begin() + i + 1);
+                    break;
+                }
+            }
+            Count = std::min(Count, Ply == 0 ? 225 : Width);
+            bool Bk = Bo.IsBlackTurn();
+            int Origin = Alpha;
+            int Score = -Win;
+            Position Chosen = Position::Null;
+            for (int i = 0; i < Count; ++i)
+            {
+                ++St.Nodes;
+                if (Expired()) { break; }
+                Position Po = Moves[i].Po;
+                int Value = 0;
+                if (Moves[i].Th == MoveGenerator::Threat::Win) { Value = Win - Ply; }
+                else
+                {
+                    Bo[Po] = Bk ? Chess::Black : Chess::White;
+                    ++Bo;
+                    Ev.Update(Po);
+                    if (Bo.IsEnded()) { Value = 0; }
+                    else if (Depth <= 1) { Value = -Ev.Evaluate(); }
+                    else { Value = -Search(Depth - 1, -Beta, -Alpha, Ply + 1, nullptr); }
+                    Ev.Undo(Po);
+                    Bo[Po] = Chess::None;
+                    --Bo;
+                }
+                if (Stopped) { break; }
+                if (Value > Score)
+                {
+                    Score = Value;
+                    Chosen = Moves[i].Po;
+                    if (Best != nullptr) { *Best = Moves[i].Po; }
+                }
+                if (Score > Alpha) { Alpha = Score; }
+                if (Alpha >= Beta) { break; }
+            }
+            if (Tt != nullptr && !Stopped)
+            {
+                TranspositionTable::Bound Kind = Score <= Origin ? TranspositionTable::Bound::Upper
+                    : Score >= Beta ? TranspositionTable::Bound::Lower : TranspositionTable::Bound::Exact;
+                TranspositionTable::Entry Kept{ Chosen, Depth, Kind, ToTable(Score, Ply) };
+                if (Ply <= Symmetric) { Tt->StoreSymmetric(Bo.Plain(), Kept); }
+                else { Tt->Store(Bo.Hash(), Kept); }
+            }
+            return Score;
+        };
+#pragma endregion
+    };
+}
@@ -0,0 +1,230 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Referee.h"
+namespace Gomoku
+{
+    // Scores each empty point on each of its 4 lines by the Shape either side would make by putting a Chess
+    // there, so that a four on the Board shows as the points making a five, an open three as those making an
+    // open four, and a two as those making a three. A move changes only the points within 4 along its own 4
+    // lines, which are the 36 windows the Update scores again.
+    class Evaluator
+    {
+#pragma region helper-classes
+    public:
+        enum struct Shape : std::uint8_t
+        {
+            None = 0u,
+            ClosedTwo = 1u,
+            OpenTwo = 2u,
+            ClosedThree = 3u,
+            OpenThree = 4u,
+            ClosedFour = 5u,
+            OpenFour = 6u,
+            Five = 7u,
+        };
+#pragma endregion
+#pragma region constants
+    public:
+        static constexpr const int Weights[8]{ 0, 1, 6, 8, 40, 50, 400, 3000 };
+    private:
+        static constexpr const int Dx[4]{ 1, 0, 1, 1 };
+        static constexpr const int Dy[4]{ 0, 1, 1, -1 };
+        // Indexed by the side, Black first, and the 8 neighbours of a point on a line, 2 bits each from the
+        // farthest on the left, where 00 is empty, 01 is of that side and 10 is blocked.
+        static const std::array<std::uint8_t, 1u << 17> Shapes;
+#pragma endregion
+#pragma region fields
+    private:
+        LineBoard Bo;
+        std::uint8_t Cells[2][256][4];
+        int Totals[2];
+        int Counts[2][8];
+        // The lines of each point on which each side makes a five there, and the points with any of them.
+        std::uint8_t Fives[2][256];
+        int Threats[2];
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit Evaluator(const Board& Bo)
+            : Bo{ Bo }, Cells{}, Totals{}, Counts{}, Fives{}, Threats{}
+        {
+            Rescan();
+        };
+        const Board& Plain() const &
+        {
+            return Bo.Plain();
+        };
+        int Total(bool Bk) const &
+        {
+            return Totals[Bk ? 0 : 1];
+        };
+        int Count(bool Bk, Shape Sh) const &
+        {
+            return Counts[Bk ? 0 : 1][static_cast<int>(Sh)];
+        };
+        // The number of distinct points where Bk makes a five, however many of their lines do.
+        int FivePoints(bool Bk) const &
+        {
+            return Threats[Bk ? 0 : 1];
+        };
+        // Scores the Board for the side to move, which wins by making a five anywhere, and loses when the other
+        // side makes a five at 2 points or more, which one move cannot both block.
+        int Evaluate() const &
+        {
+            int Mine = Bo.IsBlackTurn() ? 0 : 1;
+            int Five = static_cast<int>(Shape::Five);
+            if (Threats[Mine] > 0) { return Weights[Five] * 100; }
+            if (Threats[1 - Mine] >= 2) { return -Weights[Five] * 100; }
+            return Totals[Mine] * 6 / 5 - Totals[1 - Mine];
+        };
+        // Puts the Chess of the side to move at Po and scores the 36 windows through Po again.
+        void Update(Position Po) &
+        {
+            Bo[Po] = Bo.IsBlackTurn() ? Chess::Black : Chess::White;
+            ++Bo;
+            Rescore(Po);
+        };
+        // Takes off the Chess put at Po by the last Update and scores the 36 windows through Po again.
+        void Undo(Position Po) &
+        {
+            Bo[Po] = Chess::None;
+            --Bo;
+            Rescore(Po);
+        };
+        // Scores all the 900 windows of the Board.
+        void Rescan() &
+        {
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                for (int X = 0; X < 15; ++X)
+                {
+                    for (int Or = 0; Or < 4; ++Or) { Score(Position{ X, Y }, Or); }
+                }
+            }
+        };
+        // Returns the Shape which Bk makes by putting a Chess at the centre of Li from the LineBoard.GetLine,
+        // which shall be empty.
+        static constexpr Shape Classify(std::uint32_t Li, bool Bk)
+        {
+            std::uint32_t Blacks = Li & ~(Li >> 1) & 0x15555u;
+            std::uint32_t Whites = (Li >> 1) & ~Li & 0x15555u;
+            std::uint32_t Empty = ~(Li | (Li >> 1)) & 0x15555u;
+            std::uint32_t Mine = Bk ? Blacks : Whites;
+            if (Mine == 0u) { return Shape::None; }
+            std::uint32_t Word = Mine | ((0x15555u & ~Mine & ~Empty) << 1);
+            std::uint32_t Index = (Word & 0xFFu) | ((Word >> 2) & 0xFF00u);
+            return static_cast<Shape>(Shapes[(Bk ? 0u : 0x10000u) | Index]);
+        };
+    private:
+        void Rescore(Position Po) &
+        {
+            int X = Po.X();
+            int Y = Po.Y();
+            for (int Or = 0; Or < 4; ++Or)
+            {
+                for (int d = -4; d <= 4; ++d)
+                {
+                    int i = X + Dx[Or] * d;
+                    int j = Y + Dy[Or] * d;
+                    if (i >= 0 && i <= 14 && j >= 0 && j <= 14) { Score(Position{ i, j }, Or); }
+                }
+            }
+        };
+        void Score(Position Po, int Or) &
+        {
+            std::uint32_t Li = Bo.GetLine(Po, static_cast<Orientation>(Or));
+            bool Empty = Bo[Po] == Chess::None;
+            for (int Side = 0; Side < 2; ++Side)
+            {
+                std::uint8_t& Cell = Cells[Side][static_cast<std::uint8_t>(Po)][Or];
+                std::uint8_t Next = Empty ? static_cast<std::uint8_t>(Classify(Li, Side == 0)) : 0u;
+                if (Next == Cell) { continue; }
+                Totals[Side] += Weights[Next] - Weights[Cell];
+                if (Cell != 0u) { --Counts[Side][Cell]; }
+                if (Next != 0u) { ++Counts[Side][Next]; }
+                std::uint8_t& Lines = Fives[Side][static_cast<std::uint8_t>(Po)];
+                if (Next == static_cast<std::uint8_t>(Shape::Five) && Lines++ == 0u) { ++Threats[Side]; }
+                else if (Cell == static_cast<std::uint8_t>(Shape::Five) && --Lines == 0u) { --Threats[Side]; }
+                Cell = Next;
+            }
+        };
+    public:
+        // Every neighbourhood is settled after those with one more Chess of that side, which have a greater
+        // index, so the table fills from the top down. A Black five shall be exactly 5 within the 9 points.
+        static constexpr std::array<std::uint8_t, 1u << 17> Tabulate()
+        {
+            std::array<std::uint8_t, 1u << 17> Result{};
+            for (std::uint32_t Side = 0u; Side < 2u; ++Side)
+            {
+                for (std::uint32_t Index = 0x10000u; Index-- > 0u;)
+                {
+                    if ((Index & (Index >> 1) & 0x5555u) != 0u) { continue; }
+                    int Cell[9]{};
+                    for (int k = 0; k < 8; ++k) { Cell[k < 4 ? k : k + 1] = static_cast<int>((Index >> (k * 2)) & Box); }
+                    Cell[4] = 1;
+                    Shape Sh = Shape::None;
+                    for (int First = 0; First <= 4 && Sh == Shape::None; ++First)
+                    {
+                        bool Run = true;
+                        for (int k = First; k < First + 5; ++k) { Run = Run && Cell[k] == 1; }
+                        if (Run && Side == 0u && ((First > 0 && Cell[First - 1] == 1) || (First < 4 && Cell[First + 5] == 1))) { Run = false; }
+                        if (Run) { Sh = Shape::Five; }
+                    }
+                    if (Sh == Shape::None)
+                    {
+                        int Fives = 0;
+                        Shape Best = Shape::None;
+                        for (int k = 0; k < 8; ++k)
+                        {
+                            if (((Index >> (k * 2)) & Box) != 0u) { continue; }
+                            Shape Next = static_cast<Shape>(Result[(Side << 16) | Index | (Bit << (k * 2))]);
+                            if (Next == Shape::Five) { ++Fives; }
+                            else if (Next > Best) { Best = Next; }
+                        }
+                        if (Fives >= 2) { Sh = Shape::OpenFour; }
+                        else if (Fives == 1) { Sh = Shape::ClosedFour; }
+                        else if (Best == Shape::OpenFour) { Sh = Shape::OpenThree; }
+                        else if (Best == Shape::ClosedFour) { Sh = Shape::ClosedThree; }
+                        else if (Best == Shape::OpenThree) { Sh = Shape::OpenTwo; }
+                        else if (Best == Shape::ClosedThree) { Sh = Shape::ClosedTwo; }
+                    }
+                    Result[(Side << 16) | Index] = static_cast<std::uint8_t>(Sh);
+                }
+            }
+            return Result;
+        };
+#pragma endregion
+    };
+#pragma region global-initializes
+    inline constexpr const std::array<std::uint8_t, 1u << 17> Evaluator::Shapes = Evaluator::Tabulate();
+#pragma endregion
+}
@@ -0,0 +1,173 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <bit>
+#include <cstdint>
+#include "Referee.h"
+namespace Gomoku
+{
+    class ForbiddenMap
+    {
+#pragma region constants
+    private:
+        static constexpr const int Dx[4]{ 1, 0, 1, 1 };
+        static constexpr const int Dy[4]{ 0, 1, 1, -1 };
+#pragma endregion
+#pragma region fields
+    private:
+        LineBoard Bo;
+        std::uint32_t Rows[15];
+        std::uint32_t Deep[15];
+        // The Counter.Match of each line through each point as if Black put a Chess there, 0 where occupied.
+        std::uint8_t Matches[256][4];
+        // The Footprint of the last BasicReferee.Forbid of each point of Deep, unset elsewhere.
+        Footprint Reach[256];
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit ForbiddenMap(const Board& Bo)
+            : Bo{ Bo }, Rows{}, Deep{}, Matches{}
+        {
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                for (int X = 0; X < 15; ++X)
+                {
+                    Position Po{ X, Y };
+                    for (int Or = 0; Or < 4; ++Or) { Classify(Po, Or); }
+                    Evaluate(Po);
+                }
+            }
+        };
+        bool operator[](Position Po) const &
+        {
+            if (Po.X() == 15 || Po.Y() == 15) { return false; }
+            return (Rows[Po.Y()] >> Po.X() & Bit) != 0u;
+        };
+        std::uint32_t Row(int Y) const &
+        {
+            return Rows[Y];
+        };
+        int Count() const &
+        {
+            int Result = 0;
+            for (std::uint32_t Li : Rows) { Result += std::popcount(Li); }
+            return Result;
+        };
+        const Board& Plain() const &
+        {
+            return Bo.Plain();
+        };
+        // Puts the Chess of the side to move at Po. Each point within 4 on the 4 lines through Po has only its
+        // line through Po classified again, and is evaluated again where that Counter.Match has changed. A point
+        // of Deep is evaluated again where Po lies on the lines of its Footprint.
+        void Update(Position Po) &
+        {
+            Bo[Po] = Bo.IsBlackTurn() ? Chess::Black : Chess::White;
+            ++Bo;
+            std::uint32_t Star[15]{};
+            std::uint32_t Dirty[15]{};
+            for (int Or = 0; Or < 4; ++Or)
+            {
+                for (int d = -4; d <= 4; ++d)
+                {
+                    int X = Po.X() + Dx[Or] * d;
+                    int Y = Po.Y() + Dy[Or] * d;
+                    if (X < 0 || X > 14 || Y < 0 || Y > 14) { continue; }
+                    Star[Y] |= Bit << X;
+                    if (Classify(Position{ X, Y }, Or)) { Dirty[Y] |= Bit << X; }
+                }
+            }
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                for (std::uint32_t Li = Deep[Y] & ~Dirty[Y]; Li != 0u; Li &= Li - 1u)
+                {
+                    int X = std::countr_zero(Li);
+                    if (Reach[static_cast<std::uint8_t>(Position{ X, Y })].Meets(Star)) { Dirty[Y] |= Bit << X; }
+                }
+            }
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                for (std::uint32_t Li = Dirty[Y]; Li != 0u; Li &= Li - 1u) { Evaluate(Position{ std::countr_zero(Li), Y }); }
+            }
+        };
+    private:
+        // Returns whether the Counter.Match has changed. A line with less than 2 other Black Chesses in its 9
+        // boxes matches nothing.
+        bool Classify(Position Po, int Or) &
+        {
+            std::uint8_t& Ma = Matches[static_cast<std::uint8_t>(Po)][Or];
+            std::uint8_t Old = Ma;
+            Ma = 0u;
+            if (Bo[Po] == Chess::None)
+            {
+                std::uint32_t Li = Bo.GetLine(Po, static_cast<Orientation>(Or));
+                std::uint32_t Stones = Li & ~(Li >> 1) & 0x15455u;
+                if ((Stones & (Stones - 1u)) != 0u)
+                {
+                    Li = (Li & ~(Box << 8)) | (static_cast<std::uint32_t>(Chess::Black) << 8);
+                    Ma = static_cast<std::uint8_t>(Counter::Classify(Counter::MySide(Li, true), true));
+                }
+            }
+            return Ma != Old;
+        };
+        // A point is forbidden at once by an overline or 2 fours, and can only be so by 2 threes otherwise, where
+        // the LineReferee decides whether each three survives.
+        void Evaluate(Position Po) &
+        {
+            int X = Po.X();
+            int Y = Po.Y();
+            Rows[Y] &= ~(Bit << X);
+            Deep[Y] &= ~(Bit << X);
+            int Threes = 0;
+            int Fours = 0;
+            bool Overline = false;
+            for (std::uint8_t Code : Matches[static_cast<std::uint8_t>(Po)])
+            {
+                Counter::Match Ma = static_cast<Counter::Match>(Code);
+                if (Ma == Counter::Match::T6) { Overline = true; }
+                else if (Ma == Counter::Match::D4) { Fours += 2; }
+                else if (Ma == Counter::Match::T4) { ++Fours; }
+                else if (Ma == Counter::Match::T3) { ++Threes; }
+            }
+            if (Overline || Fours >= 2)
+            {
+                Rows[Y] |= Bit << X;
+                return;
+            }
+            if (Threes < 2) { return; }
+            Deep[Y] |= Bit << X;
+            Footprint& Fp = Reach[static_cast<std::uint8_t>(Po)];
+            Fp.Clear();
+            Fp.Add(Po);
+            LineReferee Rf{ Bo, nullptr, &Fp };
+            if (Rf.Forbid(Po) != Forbidden::None) { Rows[Y] |= Bit << X; }
+        };
+#pragma endregion
+    };
+}
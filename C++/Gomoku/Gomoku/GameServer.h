@@ -0,0 +1,237 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ForbiddenMap.h"
+#include "Notation.h"
+#include "Referee.h"
+namespace Gomoku
+{
+    // Hosts games by number for a protocol of one command a line, each answered by one line beginning with OK
+    // or ERR, where a move is in the Notation and a Result and a Forbidden are by the Notation.Name:
+    //   NEW -> OK id
+    //   PLAY id move -> OK result forbidden
+    //   RESULT id -> OK result last rounds
+    //   FORBIDDEN id -> OK move...
+    //   CLOSE id -> OK
+    // The games lie in Shards by their number, each behind a mutex of its own, so that commands for games of
+    // different Shards run side by side.
+    class GameServer
+    {
+#pragma region constants
+    public:
+        static constexpr const std::uint32_t Shards = 64u;
+#pragma endregion
+#pragma region helper-classes
+    private:
+        // The ForbiddenMap of a game is built by its first FORBIDDEN and kept in step with every PLAY after.
+        struct Game
+        {
+        public:
+            Board Bo;
+            Result Re;
+            Position Last;
+            bool Open;
+            std::unique_ptr<ForbiddenMap> Fm;
+            Game()
+                : Bo{}, Re{ Result::None }, Last{ Position::Null }, Open{ true }, Fm{}
+            {};
+        };
+        struct Shard
+        {
+        public:
+            std::mutex Lock;
+            std::vector<Game> Games;
+            std::vector<std::uint32_t> Free;
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        std::unique_ptr<Shard[]> Table;
+        std::atomic<std::uint32_t> Next;
+        std::atomic<std::uint64_t> Commands;
+        std::atomic<std::int64_t> Live;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        GameServer()
+            : Table{ std::make_unique<Shard[]>(Shards) }, Next{ 0u }, Commands{ 0u }, Live{ 0 }
+        {};
+        GameServer(const GameServer&) = delete;
+        GameServer& operator =(const GameServer&) = delete;
+        std::uint64_t Executed() const &
+        {
+            return Commands.load(std::memory_order_relaxed);
+        };
+        std::int64_t Games() const &
+        {
+            return Live.load(std::memory_order_relaxed);
+        };
+        // Runs the command of Line, without its line break, and appends the answer with its line break to Reply.
+        void Execute(std::string_view Line, std::string& Reply) &
+        {
+            Commands.fetch_add(1u, std::memory_order_relaxed);
+            while (!Line.empty() && (Line.back() == '\r' || Line.back() == ' ')) { Line.remove_suffix(1); }
+            std::string_view Command = Token(Line);
+            if (Command == "NEW")
+            {
+                Reply += "OK ";
+                Append(Reply, Create());
+                Reply += '\n';
+                return;
+            }
+            std::uint32_t Id = 0u;
+            std::string_view Number = Token(Line);
+            std::from_chars_result Fr = std::from_chars(Number.data(), Number.data() + Number.size(), Id);
+            if (Fr.ec != std::errc{} || Fr.ptr != Number.data() + Number.size() || Number.empty())
+            {
+                Reply += Command == "PLAY" || Command == "RESULT" || Command == "FORBIDDEN" || Command == "CLOSE" ? "ERR id\n" : "ERR command\n";
+                return;
+            }
+            Shard& Sh = Table[Id % Shards];
+            std::lock_guard<std::mutex> Guard{ Sh.Lock };
+            std::uint32_t Index = Id / Shards;
+            if (Index >= Sh.Games.size() || !Sh.Games[Index].Open)
+            {
+                Reply += "ERR id\n";
+                return;
+            }
+            Game& Ga = Sh.Games[Index];
+            if (Command == "PLAY")
+            {
+                std::size_t i = 0;
+                Position Po = Position::Null;
+                if (!Notation::Parse(Line, i, Po) || i != Line.size()) { Reply += "ERR move\n"; }
+                else if (Ga.Re != Result::None) { Reply += "ERR over\n"; }
+                else if (Ga.Bo[Po] != Chess::None) { Reply += "ERR occupied\n"; }
+                else if (!Ga.Bo.CanPutChess(Po)) { Reply += "ERR opening\n"; }
+                else
+                {
+                    Referee Rf{ Ga.Bo };
+                    Verdict Ve = Rf.PutChess(Po);
+                    if (Ga.Fm != nullptr) { Ga.Fm->Update(Po); }
+                    Ga.Re = Ve.Re;
+                    Ga.Last = Po;
+                    Reply += "OK ";
+                    Reply += Notation::Name(Ve.Re);
+                    Reply += ' ';
+                    Reply += Notation::Name(Ve.Fo);
+                    Reply += '\n';
+                }
+            }
+            else if (Command == "RESULT")
+            {
+                Reply += "OK ";
+                Reply += Notation::Name(Ga.Re);
+                Reply += ' ';
+                Reply += Notation::Format(Ga.Last);
+                Reply += ' ';
+                Append(Reply, static_cast<std::uint32_t>(Ga.Bo.Rounds()));
+                Reply += '\n';
+            }
+            else if (Command == "FORBIDDEN")
+            {
+                Reply += "OK";
+                if (Ga.Re == Result::None && Ga.Bo.IsBlackTurn())
+                {
+                    if (Ga.Fm == nullptr) { Ga.Fm = std::make_unique<ForbiddenMap>(Ga.Bo); }
+                    for (int Y = 0; Y < 15; ++Y)
+                    {
+                        for (std::uint32_t Li = Ga.Fm->Row(Y); Li != 0u; Li &= Li - 1u)
+                        {
+                            Reply += ' ';
+                            Reply += Notation::Format(Position{ std::countr_zero(Li), Y });
+                        }
+                    }
+                }
+                Reply += '\n';
+            }
+            else if (Command == "CLOSE")
+            {
+                Ga.Open = false;
+                Ga.Fm.reset();
+                Sh.Free.push_back(Index);
+                Live.fetch_sub(1, std::memory_order_relaxed);
+                Reply += "OK\n";
+            }
+            else { Reply += "ERR command\n"; }
+        };
+    private:
+        // Takes a game of the next Shard in turn, reusing a closed one where there is.
+        std::uint32_t Create() &
+        {
+            std::uint32_t Turn = Next.fetch_add(1u, std::memory_order_relaxed) % Shards;
+            Shard& Sh = Table[Turn];
+            std::lock_guard<std::mutex> Guard{ Sh.Lock };
+            std::uint32_t Index = 0u;
+            if (!Sh.Free.empty())
+            {
+                Index = Sh.Free.back();
+                Sh.Free.pop_back();
+                Sh.Games[Index] = Game{};
+            }
+            else
+            {
+                Index = static_cast<std::uint32_t>(Sh.Games.size());
+                Sh.Games.emplace_back();
+            }
+            Live.fetch_add(1, std::memory_order_relaxed);
+            return Index * Shards + Turn;
+        };
+        static std::string_view Token(std::string_view& Line)
+        {
+            std::size_t First = Line.find_first_not_of(' ');
+            if (First == std::string_view::npos)
+            {
+                Line = std::string_view{};
+                return Line;
+            }
+            std::size_t Last = Line.find(' ', First);
+            std::string_view Result = Line.substr(First, Last == std::string_view::npos ? std::string_view::npos : Last - First);
+            Line = Last == std::string_view::npos ? std::string_view{} : Line.substr(Last);
+            return Result;
+        };
+        static void Append(std::string& Reply, std::uint32_t Value)
+        {
+            char Digits[10]{};
+            std::to_chars_result Re = std::to_chars(Digits, Digits + sizeof(Digits), Value);
+            Reply.append(Digits, Re.ptr);
+        };
+#pragma endregion
+    };
+}
@@ -0,0 +1,258 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Engine.h"
+#include "Solver.h"
+namespace Gomoku
+{
+    // Speaks the Gomocup protocol of the Piskvork manager over the standard input and output, on the 15 by 15
+    // Board only, where Black is bound by the forbidden points of the Referee whichever side this brain plays.
+    // The table, the Solver and the buffers are allocated once, so that a move allocates nothing on the heap,
+    // and each move is given a budget of the monotonic clock from the moment its command was read.
+    class Gomocup
+    {
+#pragma region constants
+    private:
+        static constexpr const long Margin = 60;
+        static constexpr const long Horizon = 20;
+#pragma endregion
+#pragma region fields
+    private:
+        Board Bo;
+        TranspositionTable Tt;
+        Engine En;
+        Solver Sv;
+        std::vector<Position> Line;
+        std::vector<Position> Pieces[2];
+        std::string Text;
+        long TurnMs;
+        long MatchMs;
+        long LeftMs;
+        bool Started;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            long Megabytes = 64;
+            for (int i = 1; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--hash") == 0 && i + 1 < argc) { Megabytes = std::atol(argv[++i]); }
+                else
+                {
+                    std::fprintf(stderr, "usage: %s [--hash MB]\n", argv[0]);
+                    return 1;
+                }
+            }
+            Gomocup Gc{ static_cast<std::size_t>(std::max(Megabytes, 1l)) };
+            return Gc.Run();
+        };
+        explicit Gomocup(std::size_t Megabytes)
+            : Bo{}, Tt{ Megabytes }, En{ &Tt }, Sv{}, Line{}, Pieces{}, Text{}, TurnMs{ 5000 }, MatchMs{ 0 }, LeftMs{ 0 }, Started{ false }
+        {
+            Line.reserve(225u);
+            Pieces[0].reserve(225u);
+            Pieces[1].reserve(225u);
+            Text.reserve(256u);
+        };
+    private:
+        int Run() &
+        {
+            while (std::getline(std::cin, Text))
+            {
+                std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+                std::string_view Command{ Text };
+                while (!Command.empty() && (Command.back() == '\r' || Command.back() == ' ')) { Command.remove_suffix(1); }
+                std::string_view Word = Command.substr(0, Command.find(' '));
+                std::string_view Rest = Word.size() < Command.size() ? Command.substr(Word.size() + 1u) : std::string_view{};
+                if (Word == "START")
+                {
+                    long Size = 0;
+                    if (Number(Rest, Size) && Size == 15)
+                    {
+                        Reset();
+                        Started = true;
+                        Say("OK");
+                    }
+                    else { Say("ERROR only the size of 15 is supported"); }
+                }
+                else if (Word == "RESTART")
+                {
+                    Reset();
+                    Say("OK");
+                }
+                else if (Word == "INFO") { Inform(Rest); }
+                else if (Word == "BEGIN" && Started) { Reply(Begin); }
+                else if (Word == "TURN" && Started)
+                {
+                    Position Po = Position::Null;
+                    if (!Coordinates(Rest, Po) || Bo[Po] != Chess::None || Bo.IsEnded()) { Say("ERROR the move is not on an empty point"); }
+                    else if (!Bo.CanPutChess(Po)) { Say("ERROR the first move shall be at the centre, 7,7"); }
+                    else
+                    {
+                        Referee Rf{ Bo };
+                        Verdict Ve = Rf.PutChess(Po);
+                        if (Ve.Fo != Forbidden::None) { std::printf("MESSAGE the move is forbidden by %s\n", Ve.Fo == Forbidden::Overline ? "an overline" : Ve.Fo == Forbidden::FourFour ? "a four-four" : "a three-three"); }
+                        Reply(Begin);
+                    }
+                }
+                else if (Word == "BOARD" && Started)
+                {
+                    if (Load()) { Reply(Begin); }
+                    else { Say("ERROR the board is not valid"); }
+                }
+                else if (Word == "ABOUT") { Say("name=\"Gomoku\", version=\"1.0\", author=\"Edmond Chow\", country=\"HK\""); }
+                else if (Word == "END") { break; }
+                else if (!Word.empty()) { Say("UNKNOWN"); }
+            }
+            return 0;
+        };
+        void Reset() &
+        {
+            Bo.Reset();
+            Tt.Clear();
+        };
+        static void Say(const char* Text)
+        {
+            std::printf("%s\n", Text);
+            std::fflush(stdout);
+        };
+        static bool Number(std::string_view Text, long& Value)
+        {
+            return !Text.empty() && std::from_chars(Text.data(), Text.data() + Text.size(), Value).ec == std::errc{};
+        };
+        // Parses "x,y" with both from 0 to 14, and then a field after another comma if Field is given.
+        static bool Coordinates(std::string_view Text, Position& Po, long* Field = nullptr)
+        {
+            long X = -1;
+            long Y = -1;
+            std::from_chars_result Re = std::from_chars(Text.data(), Text.data() + Text.size(), X);
+            if (Re.ec != std::errc{} || Re.ptr == Text.data() + Text.size() || *Re.ptr != ',') { return false; }
+            Re = std::from_chars(Re.ptr + 1, Text.data() + Text.size(), Y);
+            if (Re.ec != std::errc{} || X < 0 || X > 14 || Y < 0 || Y > 14) { return false; }
+            if (Field != nullptr)
+            {
+                if (Re.ptr == Text.data() + Text.size() || *Re.ptr != ',') { return false; }
+                Re = std::from_chars(Re.ptr + 1, Text.data() + Text.size(), *Field);
+                if (Re.ec != std::errc{}) { return false; }
+            }
+            Po = Position{ static_cast<int>(X), static_cast<int>(Y) };
+            return true;
+        };
+        void Inform(std::string_view Rest) &
+        {
+            std::string_view Key = Rest.substr(0, Rest.find(' '));
+            long Value = 0;
+            if (Key.size() >= Rest.size() || !Number(Rest.substr(Key.size() + 1u), Value)) { return; }
+            if (Key == "timeout_turn") { TurnMs = Value; }
+            else if (Key == "timeout_match") { MatchMs = Value; }
+            else if (Key == "time_left") { LeftMs = Value; }
+        };
+        // Reads the lines of "x,y,field" up to DONE, where the field is 1 for this brain, which is to move, and
+        // 2 for the opponent, and puts the Chesses of both sides in turn from Black, since the Board knows the
+        // side to move by the rounds only. The field 3 marks the Chesses of a continuous game, which belong to
+        // neither side, so a board with any of them is not valid. A board not valid leaves the Board as it was.
+        bool Load() &
+        {
+            Pieces[0].clear();
+            Pieces[1].clear();
+            bool Valid = true;
+            while (std::getline(std::cin, Text))
+            {
+                std::string_view Entry{ Text };
+                while (!Entry.empty() && (Entry.back() == '\r' || Entry.back() == ' ')) { Entry.remove_suffix(1); }
+                if (Entry == "DONE") { break; }
+                Position Po = Position::Null;
+                long Field = 0;
+                if (!Coordinates(Entry, Po, &Field) || Field < 1 || Field > 2) { Valid = false; }
+                else { Pieces[Field == 1 ? 0 : 1].push_back(Po); }
+            }
+            std::size_t Mine = Pieces[0].size();
+            std::size_t Theirs = Pieces[1].size();
+            if (!Valid || (Mine != Theirs && Mine + 1u != Theirs)) { return false; }
+            std::vector<Position>& Blacks = Mine == Theirs ? Pieces[0] : Pieces[1];
+            std::vector<Position>& Whites = Mine == Theirs ? Pieces[1] : Pieces[0];
+            Board Next{};
+            for (std::size_t i = 0; i < Blacks.size() + Whites.size(); ++i)
+            {
+                Position Po = i % 2u == 0u ? Blacks[i / 2u] : Whites[i / 2u];
+                if (Next[Po] != Chess::None) { return false; }
+                Next[Po] = i % 2u == 0u ? Chess::Black : Chess::White;
+                ++Next;
+            }
+            Bo = Next;
+            return true;
+        };
+        // The time for this move from the turn limit and the share of the time left in the match over the next
+        // Horizon moves, less a Margin for the manager. A turn limit of 0 asks for a move as fast as possible,
+        // which is the least Budget of 1 ms.
+        long Budget() const &
+        {
+            long Ms = std::max(TurnMs, 0l);
+            if (MatchMs > 0 && LeftMs > 0) { Ms = std::min(Ms, LeftMs / Horizon); }
+            return std::max(Ms - Margin, 1l);
+        };
+        // Plays a win of the Solver, or otherwise the move of the Engine, within the Budget from Begin, where the
+        // Solver gives up after half of it.
+        void Reply(std::chrono::steady_clock::time_point Begin) &
+        {
+            Position Po = Position::Null;
+            std::chrono::steady_clock::time_point Halfway = Begin + std::chrono::milliseconds{ Budget() / 2 };
+            if (!Bo.IsPending() && Sv.Solve(Bo, Solver::Mode::Vcf, 12, Line, Halfway) && !Line.empty()) { Po = Line[0]; }
+            else
+            {
+                std::chrono::milliseconds Left = std::chrono::milliseconds{ Budget() } - std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - Begin);
+                Po = En.BestMove(Bo, std::max(Left, std::chrono::milliseconds{ 1 }));
+            }
+            if (Po == Position::Null || !Bo.CanPutChess(Po))
+            {
+                Say("ERROR no move is left");
+                return;
+            }
+            Referee Rf{ Bo };
+            Rf.PutChess(Po);
+            std::printf("%d,%d\n", Po.X(), Po.Y());
+            std::fflush(stdout);
+        };
+#pragma endregion
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Gomocup::Main(argc, argv);
+};
@@ -0,0 +1,312 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+namespace Gomoku
+{
+    // Counts the hot paths of the referees for each thread, keeps a histogram of how deep the S3Forbid
+    // recursion goes, and can write one Chrome trace event for each MakeResult. The referees reach it only
+    // through the GOMOKU_* macros below, which expand to nothing unless GOMOKU_INSTRUMENT is defined.
+    class Instrument
+    {
+#pragma region constants
+    public:
+#if defined(GOMOKU_INSTRUMENT)
+        static constexpr const bool Enabled = true;
+#else
+        static constexpr const bool Enabled = false;
+#endif
+        static constexpr const std::size_t Depths = 16u;
+        static constexpr const std::size_t Flush = 1u << 16;
+        enum struct Probe : std::uint32_t
+        {
+            GetLine = 0u,
+            CountMatches = 1u,
+            S3Forbid = 2u,
+            FindForbidPos = 3u,
+            MakeResult = 4u,
+        };
+        static constexpr const std::size_t Probes = 5u;
+#pragma endregion
+#pragma region helper-classes
+    public:
+        struct Totals
+        {
+        public:
+            std::uint64_t Calls[Probes];
+            std::uint64_t Histogram[Depths];
+            std::uint64_t Events;
+            std::uint32_t Deepest;
+            constexpr std::uint64_t operator [](Probe Pr) const &
+            {
+                return Calls[static_cast<std::uint32_t>(Pr)];
+            };
+        };
+        // Counts one S3Forbid and keeps the depth of the thread for as long as the call is on the stack.
+        class Descent
+        {
+        public:
+            constexpr Descent()
+            {
+                if !consteval { Instrument::Enter(); }
+            };
+            Descent(const Descent&) = delete;
+            Descent& operator =(const Descent&) = delete;
+            constexpr ~Descent()
+            {
+                if !consteval { Instrument::Leave(); }
+            };
+        };
+        // Counts one MakeResult and, while a trace is open, writes it as an event with the S3Forbid calls and the
+        // deepest recursion it took.
+        class Span
+        {
+        private:
+            std::chrono::steady_clock::time_point Begin;
+            std::uint64_t Key;
+            std::uint64_t S3;
+            std::uint64_t Lines;
+            int Rounds;
+            std::uint8_t Po;
+            bool Tracing;
+        public:
+            constexpr explicit Span(std::uint8_t Po, std::uint64_t Key, int Rounds)
+                : Begin{}, Key{ Key }, S3{ 0u }, Lines{ 0u }, Rounds{ Rounds }, Po{ Po }, Tracing{ false }
+            {
+                if !consteval { Instrument::Open(*this); }
+            };
+            Span(const Span&) = delete;
+            Span& operator =(const Span&) = delete;
+            constexpr ~Span()
+            {
+                if !consteval { Instrument::Close(*this); }
+            };
+            friend class Instrument;
+        };
+    private:
+        struct Local;
+        struct Shared
+        {
+        public:
+            std::mutex Lock;
+            std::vector<Local*> Live;
+            Totals Retired;
+            std::FILE* Trace;
+            std::atomic<bool> Tracing;
+            std::chrono::steady_clock::time_point Origin;
+            std::uint64_t Threshold;
+            std::uint32_t Threads;
+            Shared()
+                : Lock{}, Live{}, Retired{}, Trace{ nullptr }, Tracing{ false }, Origin{}, Threshold{ 0u }, Threads{ 0u }
+            {};
+        };
+        struct Local
+        {
+        public:
+            std::atomic<std::uint64_t> Calls[Probes];
+            std::atomic<std::uint64_t> Histogram[Depths];
+            std::atomic<std::uint64_t> Events;
+            std::atomic<std::uint32_t> Deepest;
+            std::uint32_t Depth;
+            std::uint32_t Peak;
+            std::uint32_t Thread;
+            std::string Buffer;
+            Local()
+                : Calls{}, Histogram{}, Events{ 0u }, Deepest{ 0u }, Depth{ 0u }, Peak{ 0u }, Thread{ 0u }, Buffer{}
+            {
+                Shared& Sh = Global();
+                std::lock_guard<std::mutex> Guard{ Sh.Lock };
+                Thread = ++Sh.Threads;
+                Sh.Live.push_back(this);
+            };
+            Local(const Local&) = delete;
+            Local& operator =(const Local&) = delete;
+            ~Local()
+            {
+                Shared& Sh = Global();
+                std::lock_guard<std::mutex> Guard{ Sh.Lock };
+                Gather(Sh.Retired);
+                Spill(Sh);
+                std::erase(Sh.Live, this);
+            };
+            void Gather(Totals& To) const &
+            {
+                for (std::size_t i = 0; i < Probes; ++i) { To.Calls[i] += Calls[i].load(std::memory_order_relaxed); }
+                for (std::size_t i = 0; i < Depths; ++i) { To.Histogram[i] += Histogram[i].load(std::memory_order_relaxed); }
+                To.Events += Events.load(std::memory_order_relaxed);
+                if (Deepest.load(std::memory_order_relaxed) > To.Deepest) { To.Deepest = Deepest.load(std::memory_order_relaxed); }
+            };
+            void Spill(Shared& Sh) &
+            {
+                if (Sh.Trace != nullptr && !Buffer.empty()) { std::fwrite(Buffer.data(), 1u, Buffer.size(), Sh.Trace); }
+                Buffer.clear();
+            };
+        };
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        static void Count(Probe Pr)
+        {
+            Bump(This().Calls[static_cast<std::uint32_t>(Pr)]);
+        };
+        // Sums the counters of every thread, including those which have already ended.
+        static Totals Snapshot()
+        {
+            Shared& Sh = Global();
+            std::lock_guard<std::mutex> Guard{ Sh.Lock };
+            Totals To = Sh.Retired;
+            for (const Local* Lo : Sh.Live) { Lo->Gather(To); }
+            return To;
+        };
+        static void Print(std::FILE* Fi)
+        {
+            Totals To = Snapshot();
+            std::fprintf(Fi, "getline %llu, countmatches %llu, s3forbid %llu, findforbidpos %llu, makeresult %llu, deepest recursion %u\n",
+                static_cast<unsigned long long>(To[Probe::GetLine]), static_cast<unsigned long long>(To[Probe::CountMatches]),
+                static_cast<unsigned long long>(To[Probe::S3Forbid]), static_cast<unsigned long long>(To[Probe::FindForbidPos]),
+                static_cast<unsigned long long>(To[Probe::MakeResult]), To.Deepest);
+            std::fprintf(Fi, "s3forbid depth");
+            for (std::size_t i = 0; i < Depths; ++i)
+            {
+                if (To.Histogram[i] == 0u) { continue; }
+                std::fprintf(Fi, " %zu%s:%llu", i + 1u, i + 1u == Depths ? "+" : "", static_cast<unsigned long long>(To.Histogram[i]));
+            }
+            std::fprintf(Fi, "\n");
+        };
+        // Opens a Chrome trace at Path. Only the MakeResult calls with at least Threshold S3Forbid calls below them
+        // are written, so that a whole run can be traced for the few points that blow up.
+        static bool Trace(const char* Path, std::uint64_t Threshold = 0u)
+        {
+            Shared& Sh = Global();
+            std::lock_guard<std::mutex> Guard{ Sh.Lock };
+            if (Sh.Trace != nullptr) { return false; }
+            Sh.Trace = std::fopen(Path, "wb");
+            if (Sh.Trace == nullptr) { return false; }
+            std::fputs("[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Gomoku\"}}", Sh.Trace);
+            Sh.Origin = std::chrono::steady_clock::now();
+            Sh.Threshold = Threshold;
+            Sh.Tracing.store(true, std::memory_order_release);
+            return true;
+        };
+        // Writes the events still buffered by every thread and closes the trace, which must be done while no
+        // thread is inside a referee.
+        static void Finish()
+        {
+            Shared& Sh = Global();
+            std::lock_guard<std::mutex> Guard{ Sh.Lock };
+            if (Sh.Trace == nullptr) { return; }
+            Sh.Tracing.store(false, std::memory_order_release);
+            for (Local* Lo : Sh.Live) { Lo->Spill(Sh); }
+            std::fputs("\n]\n", Sh.Trace);
+            std::fclose(Sh.Trace);
+            Sh.Trace = nullptr;
+        };
+    private:
+        static Shared& Global()
+        {
+            static Shared Sh{};
+            return Sh;
+        };
+        static Local& This()
+        {
+            thread_local Local Lo{};
+            return Lo;
+        };
+        // Only the owning thread writes its counters, so a relaxed load and store is enough and avoids a locked add.
+        static void Bump(std::atomic<std::uint64_t>& At)
+        {
+            At.store(At.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+        };
+        static void Enter()
+        {
+            Local& Lo = This();
+            Bump(Lo.Calls[static_cast<std::uint32_t>(Probe::S3Forbid)]);
+            Bump(Lo.Histogram[Lo.Depth < Depths ? Lo.Depth : Depths - 1u]);
+            if (++Lo.Depth > Lo.Peak) { Lo.Peak = Lo.Depth; }
+            if (Lo.Depth > Lo.Deepest.load(std::memory_order_relaxed)) { Lo.Deepest.store(Lo.Depth, std::memory_order_relaxed); }
+        };
+        static void Leave()
+        {
+            --This().Depth;
+        };
+        static void Open(Span& Sp)
+        {
+            Local& Lo = This();
+            Bump(Lo.Calls[static_cast<std::uint32_t>(Probe::MakeResult)]);
+            if (!Global().Tracing.load(std::memory_order_acquire)) { return; }
+            Sp.Tracing = true;
+            Sp.S3 = Lo.Calls[static_cast<std::uint32_t>(Probe::S3Forbid)].load(std::memory_order_relaxed);
+            Sp.Lines = Lo.Calls[static_cast<std::uint32_t>(Probe::GetLine)].load(std::memory_order_relaxed);
+            Lo.Peak = 0u;
+            Sp.Begin = std::chrono::steady_clock::now();
+        };
+        static void Close(const Span& Sp)
+        {
+            if (!Sp.Tracing) { return; }
+            std::chrono::steady_clock::time_point End = std::chrono::steady_clock::now();
+            Local& Lo = This();
+            Shared& Sh = Global();
+            std::uint64_t S3 = Lo.Calls[static_cast<std::uint32_t>(Probe::S3Forbid)].load(std::memory_order_relaxed) - Sp.S3;
+            if (S3 < Sh.Threshold) { return; }
+            std::uint64_t Lines = Lo.Calls[static_cast<std::uint32_t>(Probe::GetLine)].load(std::memory_order_relaxed) - Sp.Lines;
+            char Text[320];
+            int Size = std::snprintf(Text, sizeof(Text),
+                ",\n{\"name\":\"MakeResult\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+                "\"args\":{\"move\":\"%c%d\",\"round\":%d,\"hash\":\"%016llx\",\"s3forbid\":%llu,\"getline\":%llu,\"depth\":%u}}",
+                Lo.Thread, std::chrono::duration<double, std::micro>(Sp.Begin - Sh.Origin).count(),
+                std::chrono::duration<double, std::micro>(End - Sp.Begin).count(), static_cast<char>('a' + (Sp.Po & 0xFu)), (Sp.Po >> 4) + 1,
+                Sp.Rounds, static_cast<unsigned long long>(Sp.Key), static_cast<unsigned long long>(S3), static_cast<unsigned long long>(Lines), Lo.Peak);
+            if (Size <= 0) { return; }
+            Lo.Buffer.append(Text, static_cast<std::size_t>(Size) < sizeof(Text) ? static_cast<std::size_t>(Size) : sizeof(Text) - 1u);
+            Bump(Lo.Events);
+            if (Lo.Buffer.size() >= Flush)
+            {
+                std::lock_guard<std::mutex> Guard{ Sh.Lock };
+                Lo.Spill(Sh);
+            }
+        };
+#pragma endregion
+    };
+}
+#if defined(GOMOKU_INSTRUMENT)
+#define GOMOKU_COUNT(Pr) if !consteval { ::Gomoku::Instrument::Count(::Gomoku::Instrument::Probe::Pr); }
+#define GOMOKU_DESCENT() ::Gomoku::Instrument::Descent GomokuDescent{}
+#define GOMOKU_SPAN(Po, Key, Rounds) ::Gomoku::Instrument::Span GomokuSpan{ static_cast<std::uint8_t>(Po), Key, Rounds }
+#else
+#define GOMOKU_COUNT(Pr)
+#define GOMOKU_DESCENT()
+#define GOMOKU_SPAN(Po, Key, Rounds)
+#endif
@@ -0,0 +1,106 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "Engine.h"
+#include "Scheduler.h"
+#include "TranspositionTable.h"
+namespace Gomoku
+{
+    // Runs one Engine per thread on its own copy of the Board, all sharing one TranspositionTable, where every
+    // odd Engine deepens one move ahead of the even ones. The search ends when the first Engine does, and the
+    // move of the Engine which completed the deepest search is played.
+    class LazySmp
+    {
+#pragma region fields
+    private:
+        TranspositionTable& Tt;
+        Scheduler Sc;
+        std::atomic<bool> Abort;
+        Engine::Stats St;
+        const EndgameTable* Et;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit LazySmp(TranspositionTable& Tt, unsigned Threads)
+            : Tt{ Tt }, Sc{ Threads }, Abort{ false }, St{}, Et{ nullptr }
+        {};
+        // Has every Engine consult Et.
+        void Consult(const EndgameTable* Et) &
+        {
+            this->Et = Et;
+        };
+        unsigned Threads() const &
+        {
+            return Sc.Threads();
+        };
+        const Engine::Stats& LastStats() const &
+        {
+            return St;
+        };
+        Position BestMove(const Board& Bo, std::chrono::milliseconds Budget, int Limit = 225) &
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            Abort.store(false, std::memory_order_relaxed);
+            Tt.NewSearch();
+            std::vector<Engine> Engines{};
+            Engines.reserve(Sc.Threads());
+            for (unsigned i = 0; i < Sc.Threads(); ++i)
+            {
+                Engines.emplace_back(&Tt, &Abort, static_cast<int>(i & 1u));
+                Engines.back().Consult(Et);
+            }
+            Sc.ParallelFor(Engines.size(), 1u, [&](std::size_t i, unsigned)
+            {
+                if (Abort.load(std::memory_order_relaxed)) { return; }
+                Engines[i].BestMove(Bo, Budget, Limit);
+                Abort.store(true, std::memory_order_relaxed);
+            });
+            std::size_t Chosen = 0u;
+            St = Engine::Stats{};
+            for (std::size_t i = 0; i < Engines.size(); ++i)
+            {
+                const Engine::Stats& Es = Engines[i].LastStats();
+                St.Nodes += Es.Nodes;
+                St.Hits += Es.Hits;
+                if (Es.Best != Position::Null && Es.Depth > Engines[Chosen].LastStats().Depth) { Chosen = i; }
+            }
+            const Engine::Stats& Best = Engines[Chosen].LastStats();
+            St.Best = Best.Best;
+            St.Score = Best.Score;
+            St.Depth = Best.Depth;
+            St.Elapsed = std::chrono::steady_clock::now() - Begin;
+            return St.Best;
+        };
+#pragma endregion
+    };
+}
@@ -0,0 +1,339 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Notation.h"
+#include "Referee.h"
+namespace Gomoku
+{
+    // Drives a GomokuServer with many games at once over a few connections, where each game always has one
+    // command in flight: a random move as soon as the last one is answered, and a new game once it ends. The
+    // time from sending a PLAY to reading its answer is the latency of the move.
+    class Load
+    {
+#pragma region helper-classes
+    private:
+        enum struct Kind : std::uint8_t
+        {
+            New = 0u,
+            Play = 1u,
+            Close = 2u,
+        };
+        struct Pending
+        {
+        public:
+            Kind Ki;
+            std::uint32_t Game;
+            Position Po;
+            std::chrono::steady_clock::time_point Sent;
+        };
+        struct Game
+        {
+        public:
+            Board Bo;
+            std::uint32_t Id;
+        };
+        struct Client
+        {
+        public:
+            int Fd;
+            std::string In;
+            std::string Out;
+            std::size_t Sent;
+            bool Waiting;
+            std::deque<Pending> Queue;
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        std::vector<Client> Clients;
+        std::vector<Game> Games;
+        std::vector<std::uint32_t> Latencies;
+        std::mt19937_64 Rng;
+        std::uint64_t Errors;
+        std::uint64_t Finished;
+        int Epoll;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            int Port = 5515;
+            const char* Path = nullptr;
+            std::size_t Count = 10000u;
+            std::size_t Connections = 100u;
+            std::size_t Moves = 500000u;
+            std::uint64_t Seed = 1u;
+            for (int i = 1; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) { Port = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) { Path = argv[++i]; }
+                else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) { Count = std::strtoull(argv[++i], nullptr, 10); }
+                else if (std::strcmp(argv[i], "--connections") == 0 && i + 1 < argc) { Connections = std::strtoull(argv[++i], nullptr, 10); }
+                else if (std::strcmp(argv[i], "--moves") == 0 && i + 1 < argc) { Moves = std::strtoull(argv[++i], nullptr, 10); }
+                else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) { Seed = std::strtoull(argv[++i], nullptr, 10); }
+                else
+                {
+                    std::fprintf(stderr, "usage: %s [--port N | --socket path] [--games N] [--connections N] [--moves N] [--seed N]\n", argv[0]);
+                    return 1;
+                }
+            }
+            if (Count == 0u || Connections == 0u) { return Main(1, argv); }
+            Load Lo{ Seed };
+            if (!Lo.Connect(Port, Path, std::min(Connections, Count)))
+            {
+                std::fprintf(stderr, "cannot connect to %s\n", Path != nullptr ? Path : std::to_string(Port).c_str());
+                return 1;
+            }
+            std::signal(SIGPIPE, SIG_IGN);
+            return Lo.Run(Count, Moves);
+        };
+        explicit Load(std::uint64_t Seed)
+            : Clients{}, Games{}, Latencies{}, Rng{ Seed }, Errors{ 0u }, Finished{ 0u }, Epoll{ epoll_create1(0) }
+        {};
+        Load(const Load&) = delete;
+        Load& operator =(const Load&) = delete;
+        ~Load()
+        {
+            for (Client& Cl : Clients) { close(Cl.Fd); }
+            close(Epoll);
+        };
+    private:
+        bool Connect(int Port, const char* Path, std::size_t Connections) &
+        {
+            for (std::size_t i = 0; i < Connections; ++i)
+            {
+                int Fd = -1;
+                if (Path != nullptr)
+                {
+                    sockaddr_un Address{};
+                    if (std::strlen(Path) >= sizeof(Address.sun_path)) { return false; }
+                    Address.sun_family = AF_UNIX;
+                    std::strcpy(Address.sun_path, Path);
+                    Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+                    if (Fd >= 0 && connect(Fd, reinterpret_cast<sockaddr*>(&Address), sizeof(Address)) != 0) { Fd = Close(Fd); }
+                }
+                else
+                {
+                    sockaddr_in Address{};
+                    Address.sin_family = AF_INET;
+                    Address.sin_port = htons(static_cast<std::uint16_t>(Port));
+                    Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+                    Fd = socket(AF_INET, SOCK_STREAM, 0);
+                    if (Fd >= 0 && connect(Fd, reinterpret_cast<sockaddr*>(&Address), sizeof(Address)) != 0) { Fd = Close(Fd); }
+                    int On = 1;
+                    if (Fd >= 0) { setsockopt(Fd, IPPROTO_TCP, TCP_NODELAY, &On, sizeof(On)); }
+                }
+                if (Fd < 0) { return false; }
+                fcntl(Fd, F_SETFL, fcntl(Fd, F_GETFL) | O_NONBLOCK);
+                Clients.push_back(Client{ Fd, {}, {}, 0u, false, {} });
+            }
+            for (std::size_t i = 0; i < Clients.size(); ++i)
+            {
+                epoll_event Add{};
+                Add.events = EPOLLIN;
+                Add.data.u64 = i;
+                epoll_ctl(Epoll, EPOLL_CTL_ADD, Clients[i].Fd, &Add);
+            }
+            return true;
+        };
+        static int Close(int Fd)
+        {
+            close(Fd);
+            return -1;
+        };
+        int Run(std::size_t Count, std::size_t Moves) &
+        {
+            Games.assign(Count, Game{ Board{}, 0u });
+            Latencies.reserve(Moves);
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            for (std::uint32_t i = 0; i < Count; ++i) { Send(Clients[i % Clients.size()], Pending{ Kind::New, i, Position::Null, Begin }); }
+            for (Client& Cl : Clients) { Flush(Cl); }
+            std::vector<epoll_event> Ready(Clients.size());
+            char Buffer[1u << 16];
+            while (Latencies.size() < Moves)
+            {
+                int Number = epoll_wait(Epoll, Ready.data(), static_cast<int>(Ready.size()), 5000);
+                if (Number <= 0)
+                {
+                    std::fprintf(stderr, "the server stopped answering\n");
+                    return 1;
+                }
+                for (int i = 0; i < Number; ++i)
+                {
+                    Client& Cl = Clients[Ready[i].data.u64];
+                    bool Closed = (Ready[i].events & (EPOLLERR | EPOLLHUP)) != 0u;
+                    if ((Ready[i].events & EPOLLIN) != 0u)
+                    {
+                        ssize_t Read = read(Cl.Fd, Buffer, sizeof(Buffer));
+                        for (; Read > 0; Read = read(Cl.Fd, Buffer, sizeof(Buffer)))
+                        {
+                            Cl.In.append(Buffer, static_cast<std::size_t>(Read));
+                        }
+                        if (Read == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) { Closed = true; }
+                        std::size_t First = 0u;
+                        for (std::size_t End = Cl.In.find('\n'); End != std::string::npos; End = Cl.In.find('\n', First))
+                        {
+                            Answer(Cl, std::string_view{ Cl.In }.substr(First, End - First));
+                            First = End + 1u;
+                        }
+                        Cl.In.erase(0, First);
+                    }
+                    // A connection the server has closed would be ready for ever, and its games would never move.
+                    if (Closed)
+                    {
+                        std::fprintf(stderr, "the server closed a connection\n");
+                        return 1;
+                    }
+                    Flush(Cl);
+                }
+            }
+            double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Begin).count();
+            std::size_t Moved = Latencies.size();
+            auto Percentile = [&](double Share)
+            {
+                std::size_t At = std::min(static_cast<std::size_t>(Share * Moved), Moved - 1u);
+                std::nth_element(Latencies.begin(), Latencies.begin() + static_cast<std::ptrdiff_t>(At), Latencies.end());
+                return Latencies[At] / 1e3;
+            };
+            double P50 = Percentile(0.50);
+            double P99 = Percentile(0.99);
+            double Max = *std::max_element(Latencies.begin(), Latencies.end()) / 1e3;
+            std::fprintf(stderr, "games %zu, connections %zu, moves %zu, finished %llu, errors %llu, %.3f s, %.0f moves/s, p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                Count, Clients.size(), Moved, static_cast<unsigned long long>(Finished), static_cast<unsigned long long>(Errors), Seconds, Moved / Seconds, P50, P99, Max);
+            return Errors == 0u ? 0 : 2;
+        };
+        void Send(Client& Cl, const Pending& Pe) &
+        {
+            if (Pe.Ki == Kind::New) { Cl.Out += "NEW\n"; }
+            else
+            {
+                Cl.Out += Pe.Ki == Kind::Play ? "PLAY " : "CLOSE ";
+                Cl.Out += std::to_string(Games[Pe.Game].Id);
+                if (Pe.Ki == Kind::Play)
+                {
+                    Cl.Out += ' ';
+                    Cl.Out += Notation::Format(Pe.Po);
+                }
+                Cl.Out += '\n';
+            }
+            Cl.Queue.push_back(Pe);
+        };
+        // Sends a random move of the game, which is the center on an empty Board.
+        void Move(Client& Cl, std::uint32_t Index) &
+        {
+            Board& Bo = Games[Index].Bo;
+            Position Po{ 7, 7 };
+            while (!Bo.CanPutChess(Po)) { Po = Position{ static_cast<int>(Rng() % 15u), static_cast<int>(Rng() % 15u) }; }
+            Send(Cl, Pending{ Kind::Play, Index, Po, std::chrono::steady_clock::now() });
+        };
+        void Answer(Client& Cl, std::string_view Line) &
+        {
+            if (Cl.Queue.empty())
+            {
+                ++Errors;
+                return;
+            }
+            Pending Pe = Cl.Queue.front();
+            Cl.Queue.pop_front();
+            if (Line.substr(0, 2) != "OK")
+            {
+                ++Errors;
+                return;
+            }
+            Game& Ga = Games[Pe.Game];
+            if (Pe.Ki == Kind::New)
+            {
+                Ga.Id = static_cast<std::uint32_t>(std::strtoul(std::string{ Line.substr(3) }.c_str(), nullptr, 10));
+                Ga.Bo = Board{};
+                Move(Cl, Pe.Game);
+            }
+            else if (Pe.Ki == Kind::Play)
+            {
+                Latencies.push_back(static_cast<std::uint32_t>(std::min<std::int64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Pe.Sent).count(), UINT32_MAX)));
+                Ga.Bo[Pe.Po] = Ga.Bo.IsBlackTurn() ? Chess::Black : Chess::White;
+                ++Ga.Bo;
+                if (Line.substr(3, 4) == "None") { Move(Cl, Pe.Game); }
+                else
+                {
+                    ++Finished;
+                    Send(Cl, Pending{ Kind::Close, Pe.Game, Position::Null, Pe.Sent });
+                    Send(Cl, Pending{ Kind::New, Pe.Game, Position::Null, Pe.Sent });
+                }
+            }
+        };
+        void Flush(Client& Cl) &
+        {
+            while (Cl.Sent < Cl.Out.size())
+            {
+                ssize_t Written = write(Cl.Fd, Cl.Out.data() + Cl.Sent, Cl.Out.size() - Cl.Sent);
+                if (Written <= 0) { break; }
+                Cl.Sent += static_cast<std::size_t>(Written);
+            }
+            if (Cl.Sent == Cl.Out.size())
+            {
+                Cl.Out.clear();
+                Cl.Sent = 0u;
+            }
+            bool Waiting = !Cl.Out.empty();
+            if (Waiting != Cl.Waiting)
+            {
+                epoll_event Mod{};
+                Mod.events = EPOLLIN | (Waiting ? EPOLLOUT : 0u);
+                Mod.data.u64 = static_cast<std::uint64_t>(&Cl - Clients.data());
+                epoll_ctl(Epoll, EPOLL_CTL_MOD, Cl.Fd, &Mod);
+                Cl.Waiting = Waiting;
+            }
+        };
+#pragma endregion
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Load::Main(argc, argv);
+};
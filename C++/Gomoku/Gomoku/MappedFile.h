@@ -0,0 +1,117 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+namespace Gomoku
+{
+    // Maps a whole file read-only into memory for as long as it lives, where a file which cannot be mapped or
+    // is empty leaves Data null.
+    class MappedFile
+    {
+#pragma region fields
+    private:
+        const std::uint8_t* Base;
+        std::size_t Length;
+#if defined(_WIN32)
+        HANDLE File;
+        HANDLE Mapping;
+#else
+        int File;
+#endif
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit MappedFile(const std::string& Path)
+            : Base{ nullptr }, Length{ 0u }
+#if defined(_WIN32)
+            , File{ INVALID_HANDLE_VALUE }, Mapping{ nullptr }
+        {
+            File = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            LARGE_INTEGER Size{};
+            if (File == INVALID_HANDLE_VALUE || !GetFileSizeEx(File, &Size) || Size.QuadPart <= 0) { return; }
+            Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (Mapping == nullptr) { return; }
+            Base = static_cast<const std::uint8_t*>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+            if (Base != nullptr) { Length = static_cast<std::size_t>(Size.QuadPart); }
+#else
+            , File{ -1 }
+        {
+            File = open(Path.c_str(), O_RDONLY);
+            struct stat Info{};
+            if (File < 0 || fstat(File, &Info) != 0 || Info.st_size <= 0) { return; }
+            void* Map = mmap(nullptr, static_cast<std::size_t>(Info.st_size), PROT_READ, MAP_PRIVATE, File, 0);
+            if (Map == MAP_FAILED) { return; }
+            Base = static_cast<const std::uint8_t*>(Map);
+            Length = static_cast<std::size_t>(Info.st_size);
+#endif
+        };
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator =(const MappedFile&) = delete;
+        ~MappedFile()
+        {
+#if defined(_WIN32)
+            if (Base != nullptr) { UnmapViewOfFile(Base); }
+            if (Mapping != nullptr) { CloseHandle(Mapping); }
+            if (File != INVALID_HANDLE_VALUE) { CloseHandle(File); }
+#else
+            if (Base != nullptr) { munmap(const_cast<std::uint8_t*>(Base), Length); }
+            if (File >= 0) { close(File); }
+#endif
+        };
+        const std::uint8_t* Data() const &
+        {
+            return Base;
+        };
+        std::size_t Size() const &
+        {
+            return Length;
+        };
+        // Tells the system that the mapping will be read from the front to the back.
+        void Sequential() const &
+        {
+#if !defined(_WIN32)
+            if (Base != nullptr) { madvise(const_cast<std::uint8_t*>(Base), Length, MADV_SEQUENTIAL); }
+#endif
+        };
+#pragma endregion
+    };
+}
@@ -0,0 +1,404 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "MoveGenerator.h"
+#include "Referee.h"
+#include "Scheduler.h"
+namespace Gomoku
+{
+    // Searches by Monte Carlo tree search with UCT, where the threads of its Scheduler walk one tree and every
+    // thread descending through a node adds a virtual loss to it until its playout is backed up. Nodes come from
+    // a pool allocated once, and the children of a node are the best moves of the MoveGenerator. Playouts
+    // follow threats around the last two moves, classified by the Counter tables, and otherwise play at random
+    // next to a Chess.
+    class Mcts
+    {
+#pragma region constants
+    public:
+        static constexpr const int Breadth = 24;
+    private:
+        static constexpr const std::uint32_t VirtualLoss = 3u;
+        static constexpr const double Exploration = 0.7;
+        static constexpr const int Dx[4]{ 1, 0, 1, 1 };
+        static constexpr const int Dy[4]{ 0, 1, 1, -1 };
+#pragma endregion
+#pragma region helper-classes
+    public:
+        struct Stats
+        {
+        public:
+            Position Best;
+            double Rate;
+            std::uint32_t Visits;
+            std::uint64_t Playouts;
+            std::uint64_t Nodes;
+            int Depth;
+            std::chrono::nanoseconds Elapsed;
+            constexpr Stats()
+                : Best{ Position::Null }, Rate{ 0e0 }, Visits{ 0u }, Playouts{ 0u }, Nodes{ 0u }, Depth{ 0 }, Elapsed{ 0 }
+            {};
+            constexpr double PlayoutsPerSecond() const &
+            {
+                return Elapsed.count() > 0 ? Playouts * 1e9 / Elapsed.count() : 0e0;
+            };
+        };
+    private:
+        enum struct Winner : std::uint8_t
+        {
+            None = 0u,
+            Black = 1u,
+            White = 2u,
+        };
+        // Wins counts 2 for a win and 1 for a tie of the side which played Move, over Visits playouts and the
+        // virtual losses of the threads below. The children of a node are published by State turning 2.
+        struct Node
+        {
+        public:
+            std::atomic<std::uint32_t> Visits;
+            std::atomic<std::uint32_t> Wins;
+            std::uint32_t First;
+            std::uint8_t Count;
+            std::uint8_t Move;
+            std::atomic<std::uint8_t> State;
+            Node()
+                : Visits{ 0u }, Wins{ 0u }, First{ 0u }, Count{ 0u }, Move{ Byte }, State{ 0u }
+            {};
+            void Reset(std::uint8_t Po) &
+            {
+                Visits.store(0u, std::memory_order_relaxed);
+                Wins.store(0u, std::memory_order_relaxed);
+                First = 0u;
+                Count = 0u;
+                Move = Po;
+                State.store(0u, std::memory_order_relaxed);
+            };
+        };
+        // The state of one playout, copied from the root for every playout.
+        struct Playout
+        {
+        public:
+            LineBoard Bo;
+            std::uint32_t Stones[15];
+            std::uint32_t Near[15];
+            std::uint8_t Last[2];
+            Playout()
+                : Bo{}, Stones{}, Near{}, Last{ Byte, Byte }
+            {};
+            void Put(Position Po) &
+            {
+                int X = Po.X();
+                int Y = Po.Y();
+                Bo[Po] = Bo.IsBlackTurn() ? Chess::Black : Chess::White;
+                ++Bo;
+                Stones[Y] |= Bit << X;
+                std::uint32_t Span = ((0b111u << X) >> 1) & 0x7FFFu;
+                for (int i = std::max(Y - 1, 0), E = std::min(Y + 1, 14); i <= E; ++i) { Near[i] |= Span; }
+                Last[1] = Last[0];
+                Last[0] = static_cast<std::uint8_t>(Po);
+            };
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        std::unique_ptr<Node[]> Pool;
+        std::size_t Capacity;
+        std::atomic<std::size_t> Used;
+        Scheduler Sc;
+        std::uint64_t Seed;
+        Stats St;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit Mcts(unsigned Threads = 1u, std::size_t Megabytes = 64u, std::uint64_t Seed = 0u)
+            : Pool{}, Capacity{ std::max<std::size_t>((Megabytes << 20) / sizeof(Node), Breadth + 1u) }, Used{ 0u }, Sc{ Threads }, Seed{ Seed }, St{}
+        {
+            Pool = std::make_unique<Node[]>(Capacity);
+        };
+        unsigned Threads() const &
+        {
+            return Sc.Threads();
+        };
+        const Stats& LastStats() const &
+        {
+            return St;
+        };
+        // Runs playouts until Budget elapses or Limit playouts have been made, and plays the most visited move.
+        Position BestMove(const Board& Bo, std::chrono::milliseconds Budget, std::uint64_t Limit = ~0ull) &
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            std::chrono::steady_clock::time_point Deadline = Begin + Budget;
+            St = Stats{};
+            if (Bo.IsPending()) { St.Best = Position{ 7, 7 }; }
+            if (Bo.IsPending() || Bo.IsEnded())
+            {
+                St.Elapsed = std::chrono::steady_clock::now() - Begin;
+                return St.Best;
+            }
+            Playout Root{};
+            Root.Bo = LineBoard{ Bo };
+            for (Board::ChessCRef Ch : Bo)
+            {
+                if (Ch == Chess::None) { continue; }
+                int X = Ch.Pos().X();
+                int Y = Ch.Pos().Y();
+                Root.Stones[Y] |= Bit << X;
+                std::uint32_t Span = ((0b111u << X) >> 1) & 0x7FFFu;
+                for (int i = std::max(Y - 1, 0), E = std::min(Y + 1, 14); i <= E; ++i) { Root.Near[i] |= Span; }
+            }
+            Used.store(1u, std::memory_order_relaxed);
+            Pool[0].Reset(Byte);
+            Expand(Pool[0], Root);
+            std::atomic<std::uint64_t> Playouts{ 0u };
+            std::vector<int> Depths(Sc.Threads(), 0);
+            Sc.ParallelFor(Sc.Threads(), 1u, [&](std::size_t i, unsigned)
+            {
+                std::mt19937_64 Rng{ Seed ^ (0x9E3779B97F4A7C15ull * (i + 1u)) ^ Bo.Hash() };
+                std::uint32_t Path[226]{};
+                Playout Pl{};
+                for (std::uint64_t n = 0u; ; ++n)
+                {
+                    if ((n & 15u) == 0u && std::chrono::steady_clock::now() >= Deadline) { break; }
+                    if (Playouts.fetch_add(1u, std::memory_order_relaxed) >= Limit) { break; }
+                    Pl = Root;
+                    int Length = 0;
+                    Winner Wi = Descend(Pl, Path, Length);
+                    if (Wi == Winner::None && !Pl.Bo.IsEnded()) { Wi = Rollout(Pl, Rng); }
+                    Backup(Path, Length, Bo.IsBlackTurn(), Wi);
+                    Depths[i] = std::max(Depths[i], Length - 1);
+                }
+            });
+            const Node& Top = Pool[0];
+            for (std::uint32_t i = 0; i < Top.Count; ++i)
+            {
+                const Node& Ch = Pool[Top.First + i];
+                std::uint32_t Visits = Ch.Visits.load(std::memory_order_relaxed);
+                if (St.Best != Position::Null && Visits <= St.Visits) { continue; }
+                St.Best = Position{ Ch.Move };
+                St.Visits = Visits;
+                St.Rate = Visits > 0u ? Ch.Wins.load(std::memory_order_relaxed) / (2e0 * Visits) : 0e0;
+            }
+            St.Playouts = std::min(Playouts.load(std::memory_order_relaxed), Limit);
+            St.Nodes = std::min(Used.load(std::memory_order_relaxed), Capacity);
+            St.Depth = *std::max_element(Depths.begin(), Depths.end());
+            St.Elapsed = std::chrono::steady_clock::now() - Begin;
+            return St.Best;
+        };
+    private:
+        // Whether the Chess just put at Po makes five for its side, where a Black move has already passed the
+        // MoveGenerator.Legal.
+        static bool Five(const LineBoard& Bo, Position Po, bool Bk)
+        {
+            for (int Or = 0; Or < 4; ++Or)
+            {
+                Counter::Match Ma = Counter::Classify(Counter::MySide(Bo.GetLine(Po, static_cast<Orientation>(Or)), Bk), true);
+                if (Ma == Counter::Match::T5 || (!Bk && Ma == Counter::Match::T6)) { return true; }
+            }
+            return false;
+        };
+        void Expand(Node& No, Playout& Pl) &
+        {
+            std::uint8_t Expected = 0u;
+            if (!No.State.compare_exchange_strong(Expected, 1u, std::memory_order_acquire)) { return; }
+            MoveGenerator::Buffer Moves{};
+            int Taken = std::min(MoveGenerator::Generate(Pl.Bo, Moves), Breadth);
+            std::size_t First = Used.fetch_add(static_cast<std::size_t>(Taken), std::memory_order_relaxed);
+            if (First + static_cast<std::size_t>(Taken) > Capacity)
+            {
+                No.State.store(0u, std::memory_order_release);
+                return;
+            }
+            for (int i = 0; i < Taken; ++i) { Pool[First + i].Reset(static_cast<std::uint8_t>(Moves[i].Po)); }
+            No.First = static_cast<std::uint32_t>(First);
+            No.Count = static_cast<std::uint8_t>(Taken);
+            No.State.store(2u, std::memory_order_release);
+        };
+        // Descends by UCT from the root, expanding the first leaf which was visited before, and returns the
+        // Winner if a move on the way made five.
+        Winner Descend(Playout& Pl, std::uint32_t* Path, int& Length) &
+        {
+            std::uint32_t Index = 0u;
+            Path[Length++] = Index;
+            Pool[Index].Visits.fetch_add(VirtualLoss, std::memory_order_relaxed);
+            while (true)
+            {
+                Node& No = Pool[Index];
+                if (No.State.load(std::memory_order_acquire) != 2u)
+                {
+                    if (No.Visits.load(std::memory_order_relaxed) <= VirtualLoss) { return Winner::None; }
+                    Expand(No, Pl);
+                    if (No.State.load(std::memory_order_acquire) != 2u) { return Winner::None; }
+                }
+                if (No.Count == 0u) { return Winner::None; }
+                double Log = std::log(static_cast<double>(No.Visits.load(std::memory_order_relaxed)));
+                std::uint32_t Chosen = No.First;
+                double Score = -1e0;
+                for (std::uint32_t i = No.First, E = No.First + No.Count; i < E; ++i)
+                {
+                    std::uint32_t Visits = Pool[i].Visits.load(std::memory_order_relaxed);
+                    if (Visits == 0u)
+                    {
+                        Chosen = i;
+                        break;
+                    }
+                    double Value = Pool[i].Wins.load(std::memory_order_relaxed) / (2e0 * Visits) + Exploration * std::sqrt(Log / Visits);
+                    if (Value > Score)
+                    {
+                        Score = Value;
+                        Chosen = i;
+                    }
+                }
+                Index = Chosen;
+                Path[Length++] = Index;
+                Pool[Index].Visits.fetch_add(VirtualLoss, std::memory_order_relaxed);
+                Position Po{ Pool[Index].Move };
+                bool Bk = Pl.Bo.IsBlackTurn();
+                Pl.Put(Po);
+                if (Five(Pl.Bo, Po, Bk)) { return Bk ? Winner::Black : Winner::White; }
+                if (Pl.Bo.IsEnded()) { return Winner::None; }
+            }
+        };
+        // Plays one game out: a five of the side to move, else a block of a five of the other side, else a
+        // four, else a block of a three, else each three at even odds, found on the lines through the last two
+        // moves; otherwise any point next to a Chess. Black skips every point it is forbidden to play.
+        static Winner Rollout(Playout& Pl, std::mt19937_64& Rng)
+        {
+            while (!Pl.Bo.IsEnded())
+            {
+                bool Bk = Pl.Bo.IsBlackTurn();
+                std::uint8_t Urgent[64]{};
+                int Count = 0;
+                int Rank = 0;
+                for (std::uint8_t Center : Pl.Last)
+                {
+                    if (Center == Byte) { continue; }
+                    Position Ce{ Center };
+                    for (int Or = 0; Or < 4; ++Or)
+                    {
+                        for (int d = -4; d <= 4; ++d)
+                        {
+                            int X = Ce.X() + Dx[Or] * d;
+                            int Y = Ce.Y() + Dy[Or] * d;
+                            if (d == 0 || X < 0 || X > 14 || Y < 0 || Y > 14 || (Pl.Stones[Y] >> X & Bit) != 0u) { continue; }
+                            int Value = Urgency(Pl.Bo.GetLine(Position{ X, Y }, static_cast<Orientation>(Or)), Bk);
+                            if (Value == 1 && (Rng() & 1u) != 0u) { Value = 0; }
+                            if (Value < Rank || Value == 0) { continue; }
+                            if (Value > Rank)
+                            {
+                                Rank = Value;
+                                Count = 0;
+                            }
+                            if (Count < 64) { Urgent[Count++] = static_cast<std::uint8_t>(Position{ X, Y }); }
+                        }
+                    }
+                }
+                Position Po = Position::Null;
+                while (Count > 0 && Po == Position::Null)
+                {
+                    int i = static_cast<int>(Rng() % static_cast<std::uint64_t>(Count));
+                    if (MoveGenerator::Legal(Pl.Bo, Position{ Urgent[i] })) { Po = Position{ Urgent[i] }; }
+                    else { Urgent[i] = Urgent[--Count]; }
+                }
+                std::uint32_t Skipped[15]{};
+                while (Po == Position::Null)
+                {
+                    int Total = 0;
+                    for (int Y = 0; Y < 15; ++Y) { Total += std::popcount(Pl.Near[Y] & ~Pl.Stones[Y] & ~Skipped[Y]); }
+                    if (Total == 0) { return Winner::None; }
+                    int k = static_cast<int>(Rng() % static_cast<std::uint64_t>(Total));
+                    for (int Y = 0; Y < 15 && Po == Position::Null; ++Y)
+                    {
+                        std::uint32_t Li = Pl.Near[Y] & ~Pl.Stones[Y] & ~Skipped[Y];
+                        int Here = std::popcount(Li);
+                        if (k >= Here)
+                        {
+                            k -= Here;
+                            continue;
+                        }
+                        for (; k > 0; --k) { Li &= Li - 1u; }
+                        Position Pick{ std::countr_zero(Li), Y };
+                        if (MoveGenerator::Legal(Pl.Bo, Pick)) { Po = Pick; }
+                        else
+                        {
+                            Skipped[Y] |= Bit << Pick.X();
+                            break;
+                        }
+                    }
+                }
+                Pl.Put(Po);
+                if (Five(Pl.Bo, Po, Bk)) { return Bk ? Winner::Black : Winner::White; }
+            }
+            return Winner::None;
+        };
+        // Ranks an empty point by the Counter.Classify of its line Li as if either side put a Chess there: 5
+        // for a five of Bk, 4 for a five of the other side, 3 for a four of Bk, 2 for a four of the other side
+        // and 1 for a three of Bk.
+        static int Urgency(std::uint32_t Li, bool Bk)
+        {
+            std::uint32_t Blacks = Li & ~(Li >> 1) & 0x15455u;
+            std::uint32_t Whites = (Li >> 1) & ~Li & 0x15455u;
+            int Result = 0;
+            for (int Side = 0; Side < 2; ++Side)
+            {
+                bool Black = (Side == 0) == Bk;
+                std::uint32_t Own = Black ? Blacks : Whites;
+                if ((Own & (Own - 1u)) == 0u) { continue; }
+                std::uint32_t Mine = (Li & ~(Box << 8)) | (static_cast<std::uint32_t>(Black ? Chess::Black : Chess::White) << 8);
+                Counter::Match Ma = Counter::Classify(Counter::MySide(Mine, Black), true);
+                bool Attack = Side == 0;
+                if (Ma == Counter::Match::T5 || (!Black && Ma == Counter::Match::T6)) { Result = std::max(Result, Attack ? 5 : 4); }
+                else if (Ma == Counter::Match::T4 || Ma == Counter::Match::D4) { Result = std::max(Result, Attack ? 3 : 2); }
+                else if (Ma == Counter::Match::T3 && Attack) { Result = std::max(Result, 1); }
+            }
+            return Result;
+        };
+        void Backup(const std::uint32_t* Path, int Length, bool Bk, Winner Wi) &
+        {
+            for (int i = 0; i < Length; ++i)
+            {
+                Node& No = Pool[Path[i]];
+                No.Visits.fetch_sub(VirtualLoss - 1u, std::memory_order_relaxed);
+                if (i == 0) { continue; }
+                bool Mover = (i % 2 == 1) == Bk;
+                if (Wi == Winner::None) { No.Wins.fetch_add(1u, std::memory_order_relaxed); }
+                else if ((Wi == Winner::Black) == Mover) { No.Wins.fetch_add(2u, std::memory_order_relaxed); }
+            }
+        };
+#pragma endregion
+    };
+}
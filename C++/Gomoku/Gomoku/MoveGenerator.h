@@ -0,0 +1,188 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include "Evaluator.h"
+#include "Referee.h"
+namespace Gomoku
+{
+    // Generates the empty points within Radius of a Chess, ordered by the strongest Threat a point makes or
+    // stops on any of its lines and then by the Evaluator.Weights of the Shapes of both sides there, leaving
+    // out the points where Black is forbidden to play. The moves are sorted as one word each on the stack and
+    // written into a Buffer of the caller, and nothing is allocated.
+    class MoveGenerator
+    {
+#pragma region helper-classes
+    public:
+        enum struct Threat : std::uint8_t
+        {
+            None = 0u,
+            BlockThree = 1u,
+            MakeThree = 2u,
+            BlockFour = 3u,
+            MakeFour = 4u,
+            BlockFive = 5u,
+            Win = 6u,
+        };
+        struct Move
+        {
+        public:
+            Position Po;
+            Threat Th;
+            int Score;
+            constexpr Move()
+                : Po{ Position::Null }, Th{ Threat::None }, Score{ 0 }
+            {};
+            constexpr Move(Position Po, Threat Th, int Score)
+                : Po{ Po }, Th{ Th }, Score{ Score }
+            {};
+            constexpr bool operator >(const Move& Other) const &
+            {
+                return Th != Other.Th ? Th > Other.Th : Score > Other.Score;
+            };
+        };
+        using Buffer = std::array<Move, 225>;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        // Returns the number of moves written, which is only the centre before the first move.
+        template <typename B>
+        static int Generate(B& Bo, Buffer& Moves, int Radius = 2)
+        {
+            if (Bo.IsEnded()) { return 0; }
+            if (Bo.IsPending())
+            {
+                Moves[0] = Move{ Position{ 7, 7 }, Threat::None, 0 };
+                return 1;
+            }
+            std::uint32_t Stones[15]{};
+            std::uint32_t Near[15]{};
+            Neighbours(Bo, Radius, Stones, Near);
+            bool Bk = Bo.IsBlackTurn();
+            std::uint32_t Keys[225]{};
+            int Count = 0;
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                for (std::uint32_t Li = Near[Y] & ~Stones[Y]; Li != 0u; Li &= Li - 1u)
+                {
+                    Position Po{ std::countr_zero(Li), Y };
+                    if (Bk && !Legal(Bo, Po)) { continue; }
+                    Move Mo = Rate(Bo, Po, Bk);
+                    Keys[Count++] = (static_cast<std::uint32_t>(Mo.Th) << 28) | (static_cast<std::uint32_t>(Mo.Score) << 8) | static_cast<std::uint32_t>(Po);
+                }
+            }
+            std::sort(Keys, Keys + Count, [](std::uint32_t L, std::uint32_t R) { return L > R; });
+            for (int i = 0; i < Count; ++i)
+            {
+                Moves[i] = Move{ Position{ static_cast<std::uint8_t>(Keys[i] & Byte) }, static_cast<Threat>(Keys[i] >> 28), static_cast<int>((Keys[i] >> 8) & 0xFFFFFu) };
+            }
+            return Count;
+        };
+        // Marks the rows of Chesses into Stones, and the empty points within Radius of any of them into Near.
+        template <typename B>
+        static void Neighbours(const B& Bo, int Radius, std::uint32_t (&Stones)[15], std::uint32_t (&Near)[15])
+        {
+            for (Board::ChessCRef Ch : Bo)
+            {
+                if (Ch != Chess::None) { Stones[Ch.Pos().Y()] |= Bit << Ch.Pos().X(); }
+            }
+            std::uint32_t Wide[15]{};
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                Wide[Y] = Stones[Y];
+                for (int r = 1; r <= Radius; ++r) { Wide[Y] |= (Stones[Y] << r) | (Stones[Y] >> r); }
+                Wide[Y] &= 0x7FFFu;
+            }
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                Near[Y] = 0u;
+                for (int i = std::max(Y - Radius, 0), E = std::min(Y + Radius, 14); i <= E; ++i) { Near[Y] |= Wide[i]; }
+                Near[Y] &= ~Stones[Y];
+            }
+        };
+        // Whether the side to move may put a Chess at the empty Po, which Black may not where forbidden.
+        template <typename B>
+        static bool Legal(B& Bo, Position Po)
+        {
+            return !Bo.IsBlackTurn() || Allowed(Bo, Po);
+        };
+        // Whether Black may put a Chess at the empty Po on either side's turn. The lines are classified first as
+        // the BasicReferee.Judge would, and only a point with 2 threes or more and neither an overline nor 2 fours
+        // needs the S3Forbid of the BasicReferee to tell its threes.
+        template <typename B>
+        static bool Allowed(B& Bo, Position Po)
+        {
+            int Fours = 0;
+            int Threes = 0;
+            for (int Or = 0; Or < 4; ++Or)
+            {
+                std::uint32_t Li = Bo.GetLine(Po, static_cast<Orientation>(Or));
+                std::uint32_t Blacks = Li & ~(Li >> 1) & 0x15455u;
+                if ((Blacks & (Blacks - 1u)) == 0u) { continue; }
+                std::uint32_t Mine = (Li & ~(Box << 8)) | (static_cast<std::uint32_t>(Chess::Black) << 8);
+                Counter::Match Ma = Counter::Classify(Counter::MySide(Mine, true), true);
+                if (Ma == Counter::Match::T6) { return false; }
+                else if (Ma == Counter::Match::D4) { Fours += 2; }
+                else if (Ma == Counter::Match::T4) { ++Fours; }
+                else if (Ma == Counter::Match::T3) { ++Threes; }
+            }
+            if (Fours >= 2) { return false; }
+            if (Threes < 2) { return true; }
+            BasicReferee<B> Rf{ Bo };
+            return Rf.Forbid(Po) == Forbidden::None;
+        };
+    private:
+        template <typename B>
+        static Move Rate(const B& Bo, Position Po, bool Bk)
+        {
+            Threat Th = Threat::None;
+            int Score = 0;
+            for (int Or = 0; Or < 4; ++Or)
+            {
+                std::uint32_t Li = Bo.GetLine(Po, static_cast<Orientation>(Or));
+                Evaluator::Shape Mine = Evaluator::Classify(Li, Bk);
+                Evaluator::Shape Theirs = Evaluator::Classify(Li, !Bk);
+                Score += Evaluator::Weights[static_cast<int>(Mine)] + Evaluator::Weights[static_cast<int>(Theirs)] * 9 / 10;
+                Threat Here = Threat::None;
+                if (Mine == Evaluator::Shape::Five) { Here = Threat::Win; }
+                else if (Theirs == Evaluator::Shape::Five) { Here = Threat::BlockFive; }
+                else if (Mine >= Evaluator::Shape::ClosedFour) { Here = Threat::MakeFour; }
+                else if (Theirs >= Evaluator::Shape::ClosedFour) { Here = Threat::BlockFour; }
+                else if (Mine == Evaluator::Shape::OpenThree) { Here = Threat::MakeThree; }
+                else if (Theirs == Evaluator::Shape::OpenThree) { Here = Threat::BlockThree; }
+                Th = std::max(Th, Here);
+            }
+            return Move{ Po, Th, Score };
+        };
+#pragma endregion
+    };
+}
@@ -0,0 +1,91 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Referee.h"
+namespace Gomoku
+{
+    struct Notation
+    {
+    public:
+        static constexpr bool Parse(std::string_view Tx, std::size_t& i, Position& Po)
+        {
+            while (i < Tx.size() && (Tx[i] == ' ' || Tx[i] == '\t' || Tx[i] == ',' || Tx[i] == ';')) { ++i; }
+            if (i >= Tx.size()) { return false; }
+            char L = Tx[i];
+            if (L >= 'A' && L <= 'O') { L = static_cast<char>(L - 'A' + 'a'); }
+            if (L < 'a' || L > 'o') { return false; }
+            int X = L - 'a';
+            int Y = 0;
+            std::size_t Digits = 0;
+            for (++i; i < Tx.size() && Tx[i] >= '0' && Tx[i] <= '9' && Digits < 2; ++i, ++Digits) { Y = Y * 10 + (Tx[i] - '0'); }
+            if (Digits == 0 || Y < 1 || Y > 15) { return false; }
+            Po = Position{ X, Y - 1 };
+            return true;
+        };
+        static bool ParseGame(std::string_view Tx, std::vector<Position>& Moves)
+        {
+            Moves.clear();
+            std::size_t i = 0;
+            Position Po = Position::Null;
+            while (Parse(Tx, i, Po)) { Moves.push_back(Po); }
+            while (i < Tx.size() && (Tx[i] == ' ' || Tx[i] == '\t' || Tx[i] == ',' || Tx[i] == ';' || Tx[i] == '\r')) { ++i; }
+            return i == Tx.size();
+        };
+        static std::string Format(Position Po)
+        {
+            if (Po.X() == 15 || Po.Y() == 15) { return std::string{ "--" }; }
+            std::string Result{ static_cast<char>('a' + Po.X()) };
+            Result += std::to_string(Po.Y() + 1);
+            return Result;
+        };
+        static constexpr const char* Name(Result Re)
+        {
+            switch (Re)
+            {
+            case Result::Won: return "Won";
+            case Result::Lost: return "Lost";
+            case Result::Tied: return "Tied";
+            default: return "None";
+            }
+        };
+        static constexpr const char* Name(Forbidden Fo)
+        {
+            switch (Fo)
+            {
+            case Forbidden::ThreeThree: return "ThreeThree";
+            case Forbidden::FourFour: return "FourFour";
+            case Forbidden::Overline: return "Overline";
+            default: return "None";
+            }
+        };
+    };
+}
@@ -0,0 +1,256 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "Referee.h"
+#include "TranspositionTable.h"
+namespace Gomoku
+{
+    // A book is the 8 bytes of Magic, the number of entries and the number of Bits of the directory as 4 bytes
+    // each, the directory of 2 to the Bits plus 1 offsets of 4 bytes, and the entries sorted by the canonical
+    // hash of their Board, 16 bytes each. The entries whose hash begins with the same Bits lie between two
+    // offsets, and the directory has as many slots as there are entries, so that a lookup reads one or two
+    // entries on average. Every number is little endian, and a move is kept as the Position in the transform
+    // of the Symmetry.Canonical.
+    class OpeningBook
+    {
+#pragma region constants
+    public:
+        static constexpr const char Magic[8]{ 'G', 'o', 'm', 'o', 'B', 'o', 'o', 'k' };
+#pragma endregion
+#pragma region helper-classes
+    public:
+        struct Entry
+        {
+        public:
+            std::uint64_t Key;
+            std::uint32_t Games;
+            std::uint16_t Rate;
+            std::uint8_t Move;
+            std::uint8_t Reserved;
+            constexpr Entry()
+                : Key{ 0u }, Games{ 0u }, Rate{ 0u }, Move{ Byte }, Reserved{ 0u }
+            {};
+            // The share of the points the move scored for its side, in 1 of 10000.
+            constexpr double Score() const &
+            {
+                return Rate / 1e4;
+            };
+        };
+        // Tallies the moves of games up to Plies from the start, and keeps for each Board the move which scored
+        // best from MinGames on.
+        class Builder
+        {
+        private:
+            struct Tally
+            {
+            public:
+                std::uint64_t Key;
+                std::uint8_t Move;
+                std::uint8_t Points;
+            };
+            std::vector<Tally> Tallies;
+            int Plies;
+        public:
+            explicit Builder(int Plies)
+                : Tallies{}, Plies{ Plies }
+            {};
+            // Adds a game judged Re, which scores 2 points for the winner of each move and 1 for either side of
+            // a tie, and none for an unfinished game.
+            void Add(const Position* Moves, int Count, Result Re) &
+            {
+                if (Re == Result::None) { return; }
+                Board Bo{};
+                for (int i = 0; i < Count && i < Plies && Bo.CanPutChess(Moves[i]); ++i)
+                {
+                    int Tr = 0;
+                    std::uint64_t Key = Symmetry::Canonical(Bo, Tr);
+                    bool Bk = Bo.IsBlackTurn();
+                    std::uint8_t Points = Re == Result::Tied ? 1u : (Re == Result::Won) == Bk ? 2u : 0u;
+                    Tallies.push_back(Tally{ Key, static_cast<std::uint8_t>(Symmetry::Apply(Moves[i], Tr)), Points });
+                    Bo[Moves[i]] = Bk ? Chess::Black : Chess::White;
+                    ++Bo;
+                }
+            };
+            std::size_t Positions() const &
+            {
+                return Tallies.size();
+            };
+            // Writes the book, returning the number of entries or -1 when the file cannot be written.
+            long Write(const std::string& Path, std::uint32_t MinGames) &
+            {
+                std::sort(Tallies.begin(), Tallies.end(), [](const Tally& L, const Tally& R) { return L.Key != R.Key ? L.Key < R.Key : L.Move < R.Move; });
+                std::vector<Entry> Entries{};
+                for (std::size_t i = 0; i < Tallies.size();)
+                {
+                    Entry Best{};
+                    std::size_t j = i;
+                    for (; j < Tallies.size() && Tallies[j].Key == Tallies[i].Key;)
+                    {
+                        std::uint32_t Games = 0u;
+                        std::uint32_t Points = 0u;
+                        std::size_t k = j;
+                        for (; k < Tallies.size() && Tallies[k].Key == Tallies[j].Key && Tallies[k].Move == Tallies[j].Move; ++k)
+                        {
+                            ++Games;
+                            Points += Tallies[k].Points;
+                        }
+                        std::uint16_t Rate = static_cast<std::uint16_t>(Points * 10000ull / (2ull * Games));
+                        if (Games >= MinGames && (Best.Games == 0u || Rate > Best.Rate || (Rate == Best.Rate && Games > Best.Games)))
+                        {
+                            Best.Key = Tallies[j].Key;
+                            Best.Games = Games;
+                            Best.Rate = Rate;
+                            Best.Move = Tallies[j].Move;
+                        }
+                        j = k;
+                    }
+                    if (Best.Games > 0u) { Entries.push_back(Best); }
+                    i = j;
+                }
+                std::uint32_t Bits = 0u;
+                while ((std::size_t{ 1 } << Bits) < Entries.size()) { ++Bits; }
+                std::vector<std::uint32_t> Directory((std::size_t{ 1 } << Bits) + 1u, 0u);
+                for (const Entry& En : Entries) { ++Directory[Bucket(En.Key, Bits) + 1u]; }
+                for (std::size_t i = 1; i < Directory.size(); ++i) { Directory[i] += Directory[i - 1]; }
+                std::ofstream File{ Path, std::ios::binary | std::ios::trunc };
+                File.write(Magic, sizeof(Magic));
+                Put(File, static_cast<std::uint32_t>(Entries.size()));
+                Put(File, Bits);
+                for (std::uint32_t Offset : Directory) { Put(File, Offset); }
+                for (const Entry& En : Entries)
+                {
+                    Put(File, En.Key);
+                    Put(File, En.Games);
+                    Put(File, En.Rate);
+                    Put(File, En.Move);
+                    Put(File, En.Reserved);
+                }
+                return File ? static_cast<long>(Entries.size()) : -1;
+            };
+        private:
+            template <typename T>
+            static void Put(std::ofstream& File, T Value)
+            {
+                char Bytes[sizeof(T)]{};
+                for (std::size_t i = 0; i < sizeof(T); ++i) { Bytes[i] = static_cast<char>((static_cast<std::uint64_t>(Value) >> (i * 8)) & Byte); }
+                File.write(Bytes, sizeof(T));
+            };
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        MappedFile Ma;
+        const std::uint8_t* Directory;
+        const std::uint8_t* Entries;
+        std::uint32_t Count;
+        std::uint32_t Bits;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        // Maps the book, which is left empty when the file is not a whole book.
+        explicit OpeningBook(const std::string& Path)
+            : Ma{ Path }, Directory{ nullptr }, Entries{ nullptr }, Count{ 0u }, Bits{ 0u }
+        {
+            const std::uint8_t* Data = Ma.Data();
+            if (Ma.Size() < sizeof(Magic) + 8u || std::memcmp(Data, Magic, sizeof(Magic)) != 0) { return; }
+            std::uint32_t Number = Get<std::uint32_t>(Data + 8);
+            std::uint32_t Width = Get<std::uint32_t>(Data + 12);
+            if (Width > 31u) { return; }
+            std::size_t Offsets = (std::size_t{ 1 } << Width) + 1u;
+            if (Ma.Size() != 16u + Offsets * 4u + static_cast<std::size_t>(Number) * 16u) { return; }
+            Directory = Data + 16;
+            Entries = Directory + Offsets * 4u;
+            Count = Number;
+            Bits = Width;
+        };
+        std::size_t Size() const &
+        {
+            return Count;
+        };
+        bool Find(std::uint64_t Key, Entry& En) const &
+        {
+            if (Count == 0u) { return false; }
+            std::size_t Slot = Bucket(Key, Bits);
+            std::uint32_t First = Get<std::uint32_t>(Directory + Slot * 4u);
+            std::uint32_t Last = std::min(Get<std::uint32_t>(Directory + Slot * 4u + 4u), Count);
+            for (std::uint32_t i = First; i < Last; ++i)
+            {
+                const std::uint8_t* At = Entries + static_cast<std::size_t>(i) * 16u;
+                std::uint64_t Here = Get<std::uint64_t>(At);
+                if (Here < Key) { continue; }
+                if (Here > Key) { return false; }
+                En.Key = Here;
+                En.Games = Get<std::uint32_t>(At + 8);
+                En.Rate = Get<std::uint16_t>(At + 12);
+                En.Move = At[14];
+                return true;
+            }
+            return false;
+        };
+        // Returns the book move for Bo mapped back from the canonical transform, or Position::Null.
+        Position Probe(const Board& Bo) const &
+        {
+            Entry En{};
+            return Probe(Bo, En);
+        };
+        Position Probe(const Board& Bo, Entry& En) const &
+        {
+            int Tr = 0;
+            if (!Find(Symmetry::Canonical(Bo, Tr), En)) { return Position::Null; }
+            Position Po = Symmetry::Apply(Position{ En.Move }, Symmetry::Inverse(Tr));
+            return Bo.CanPutChess(Po) ? Po : Position::Null;
+        };
+        // The key of the I-th entry, for walking the book in order.
+        std::uint64_t Key(std::size_t I) const &
+        {
+            return Get<std::uint64_t>(Entries + I * 16u);
+        };
+    private:
+        static constexpr std::size_t Bucket(std::uint64_t Key, std::uint32_t Bits)
+        {
+            return Bits == 0u ? 0u : static_cast<std::size_t>(Key >> (64u - Bits));
+        };
+        template <typename T>
+        static T Get(const std::uint8_t* At)
+        {
+            std::uint64_t Value = 0u;
+            for (std::size_t i = 0; i < sizeof(T); ++i) { Value |= static_cast<std::uint64_t>(At[i]) << (i * 8); }
+            return static_cast<T>(Value);
+        };
+#pragma endregion
+    };
+}
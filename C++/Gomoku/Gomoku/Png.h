@@ -0,0 +1,380 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Raster.h"
+namespace Gomoku
+{
+    // Encodes a Bitmap as a PNG of 8-bit RGB, or RGBA when any pixel is not opaque. Each row is filtered by
+    // whichever of None, Sub and Up leaves the least sum of magnitudes, and the rows are deflated in
+    // one block of the fixed Huffman codes over matches found by a hash of 3 bytes, where only the end of a
+    // match longer than Lazy is hashed. Positions in the hash count on from the last image, so that the table
+    // needs no clearing between images. The buffers are kept
+    // across calls, so that an encoder for each thread allocates nothing once it has seen the largest image.
+    class Png
+    {
+#pragma region constants
+    private:
+        static constexpr const std::uint8_t Signature[8]{ 0x89u, 'P', 'N', 'G', '\r', '\n', 0x1Au, '\n' };
+        static constexpr const int Window = 1 << 15;
+        static constexpr const int HashBits = 15;
+        static constexpr const int Chain = 16;
+        static constexpr const int MinMatch = 3;
+        static constexpr const int MaxMatch = 258;
+        static constexpr const int Lazy = 32;
+        static constexpr const std::uint16_t LengthBase[29]{ 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static constexpr const std::uint8_t LengthExtra[29]{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static constexpr const std::uint16_t DistanceBase[30]{ 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        static constexpr const std::uint8_t DistanceExtra[30]{ 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+        static constexpr std::array<std::uint32_t, 256> Crcs()
+        {
+            std::array<std::uint32_t, 256> Table{};
+            for (std::uint32_t i = 0; i < 256u; ++i)
+            {
+                std::uint32_t Crc = i;
+                for (int k = 0; k < 8; ++k) { Crc = (Crc & 1u) != 0u ? 0xEDB88320u ^ (Crc >> 1) : Crc >> 1; }
+                Table[i] = Crc;
+            }
+            return Table;
+        };
+        static const std::array<std::uint32_t, 256> CrcTable;
+        // A Huffman code goes from its most significant bit, so it is kept reversed.
+        static constexpr std::uint32_t Reverse(std::uint32_t Code, int Length)
+        {
+            std::uint32_t Reversed = 0u;
+            for (int k = 0; k < Length; ++k) { Reversed |= ((Code >> k) & 1u) << (Length - 1 - k); }
+            return Reversed;
+        };
+        // The fixed code of each literal and length symbol, reversed, shifted by 4 over its length.
+        static constexpr std::array<std::uint32_t, 288> Codes()
+        {
+            std::array<std::uint32_t, 288> Table{};
+            for (std::uint32_t Value = 0u; Value < 288u; ++Value)
+            {
+                std::uint32_t Code = Value < 144u ? 0x30u + Value : Value < 256u ? 0x190u + Value - 144u : Value < 280u ? Value - 256u : 0xC0u + Value - 280u;
+                int Length = Value < 144u ? 8 : Value < 256u ? 9 : Value < 280u ? 7 : 8;
+                Table[Value] = Reverse(Code, Length) << 4 | static_cast<std::uint32_t>(Length);
+            }
+            return Table;
+        };
+        static const std::array<std::uint32_t, 288> Literals;
+#pragma endregion
+#pragma region fields
+    private:
+        std::vector<std::uint8_t> Raw;
+        std::vector<std::uint8_t> Filtered;
+        std::vector<std::uint8_t> Trials;
+        std::vector<std::uint8_t> Zero;
+        std::vector<std::uint8_t> Out;
+        std::vector<std::int32_t> Head;
+        std::vector<std::int32_t> Prev;
+        std::uint64_t Bits;
+        int Count;
+        int Origin;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        Png()
+            : Raw{}, Filtered{}, Trials{}, Zero{}, Out{}, Head(std::size_t{ 1 } << HashBits), Prev(static_cast<std::size_t>(Window)), Bits{ 0u }, Count{ 0 }, Origin{ 0 }
+        {
+            std::fill(Head.begin(), Head.end(), -1);
+        };
+        // Returns the whole file, which stays valid until the next Encode.
+        const std::vector<std::uint8_t>& Encode(const Bitmap& Bm) &
+        {
+            int W = Bm.Width();
+            int H = Bm.Height();
+            bool Alpha = false;
+            for (int Y = 0; Y < H && !Alpha; ++Y)
+            {
+                const std::uint32_t* Ro = Bm.Row(Y);
+                for (int X = 0; X < W && !Alpha; ++X) { Alpha = Ro[X] >> 24 != 255u; }
+            }
+            int Channels = Alpha ? 4 : 3;
+            std::size_t Stride = static_cast<std::size_t>(W) * static_cast<std::size_t>(Channels);
+            Raw.resize(Stride * static_cast<std::size_t>(H));
+            for (int Y = 0; Y < H; ++Y)
+            {
+                const std::uint32_t* Ro = Bm.Row(Y);
+                std::uint8_t* To = Raw.data() + Stride * static_cast<std::size_t>(Y);
+                for (int X = 0; X < W; ++X)
+                {
+                    std::uint32_t Px = Ro[X];
+                    std::uint32_t A = Px >> 24;
+                    std::uint32_t R = Px >> 16 & 255u;
+                    std::uint32_t G = Px >> 8 & 255u;
+                    std::uint32_t B = Px & 255u;
+                    if (A != 255u && A != 0u)
+                    {
+                        R = (R * 255u + A / 2u) / A;
+                        G = (G * 255u + A / 2u) / A;
+                        B = (B * 255u + A / 2u) / A;
+                    }
+                    *To++ = static_cast<std::uint8_t>(R);
+                    *To++ = static_cast<std::uint8_t>(G);
+                    *To++ = static_cast<std::uint8_t>(B);
+                    if (Alpha) { *To++ = static_cast<std::uint8_t>(A); }
+                }
+            }
+            Filter(Stride, H, Channels);
+            Out.assign(std::begin(Signature), std::end(Signature));
+            std::size_t At = Begin("IHDR");
+            Put32(static_cast<std::uint32_t>(W));
+            Put32(static_cast<std::uint32_t>(H));
+            Out.push_back(8u);
+            Out.push_back(Alpha ? 6u : 2u);
+            Out.push_back(0u);
+            Out.push_back(0u);
+            Out.push_back(0u);
+            End(At);
+            At = Begin("IDAT");
+            Deflate();
+            End(At);
+            End(Begin("IEND"));
+            return Out;
+        };
+        static bool Write(const std::string& Path, const std::vector<std::uint8_t>& Bytes)
+        {
+            std::ofstream File{ Path, std::ios::binary | std::ios::trunc };
+            File.write(reinterpret_cast<const char*>(Bytes.data()), static_cast<std::streamsize>(Bytes.size()));
+            return static_cast<bool>(File);
+        };
+    private:
+        void Filter(std::size_t Stride, int H, int Channels) &
+        {
+            Filtered.resize((Stride + 1u) * static_cast<std::size_t>(H));
+            Trials.resize(Stride * 2u);
+            Zero.assign(Stride, 0u);
+            std::size_t Bpp = (std::min)(static_cast<std::size_t>(Channels), Stride);
+            for (int Y = 0; Y < H; ++Y)
+            {
+                const std::uint8_t* Ro = Raw.data() + Stride * static_cast<std::size_t>(Y);
+                const std::uint8_t* Up = Y > 0 ? Ro - Stride : Zero.data();
+                std::uint8_t* Sub = Trials.data();
+                std::uint8_t* Above = Sub + Stride;
+                std::uint32_t Plain = 0u;
+                std::uint32_t Left = 0u;
+                std::uint32_t Upper = 0u;
+                for (std::size_t i = 0; i < Stride; ++i) { Plain += Magnitude(Ro[i]); }
+                for (std::size_t i = 0; i < Bpp; ++i) { Sub[i] = Ro[i]; }
+                for (std::size_t i = Bpp; i < Stride; ++i) { Sub[i] = static_cast<std::uint8_t>(Ro[i] - Ro[i - Bpp]); }
+                for (std::size_t i = 0; i < Stride; ++i) { Left += Magnitude(Sub[i]); }
+                for (std::size_t i = 0; i < Stride; ++i) { Above[i] = static_cast<std::uint8_t>(Ro[i] - Up[i]); }
+                for (std::size_t i = 0; i < Stride; ++i) { Upper += Magnitude(Above[i]); }
+                std::uint8_t* To = Filtered.data() + (Stride + 1u) * static_cast<std::size_t>(Y);
+                const std::uint8_t* From = Ro;
+                To[0] = 0u;
+                if (Left < Plain && Left <= Upper)
+                {
+                    To[0] = 1u;
+                    From = Sub;
+                }
+                else if (Upper < Plain)
+                {
+                    To[0] = 2u;
+                    From = Above;
+                }
+                std::copy(From, From + Stride, To + 1);
+            }
+        };
+        static std::uint32_t Magnitude(std::uint8_t Byte)
+        {
+            return (std::min)(static_cast<std::uint32_t>(Byte), 256u - Byte);
+        };
+        void Deflate() &
+        {
+            const std::uint8_t* Data = Filtered.data();
+            int Size = static_cast<int>(Filtered.size());
+            Out.push_back(0x78u);
+            Out.push_back(0x01u);
+            Bits = 0u;
+            Count = 0;
+            Put(1u, 1);
+            Put(1u, 2);
+            if (Origin > (1 << 30) - Size)
+            {
+                std::fill(Head.begin(), Head.end(), -1);
+                Origin = 0;
+            }
+            int i = 0;
+            while (i < Size)
+            {
+                int Length = 0;
+                int Distance = 0;
+                if (i + MinMatch <= Size)
+                {
+                    std::uint32_t Hash = HashAt(Data + i);
+                    int Limit = (std::min)(MaxMatch, Size - i);
+                    int Candidate = Head[Hash] - Origin;
+                    for (int Tries = 0; Tries < Chain && Candidate >= 0 && i - Candidate <= Window; ++Tries)
+                    {
+                        int Run = Extend(Data + Candidate, Data + i, Limit);
+                        if (Run > Length)
+                        {
+                            Length = Run;
+                            Distance = i - Candidate;
+                            if (Run == Limit) { break; }
+                        }
+                        int Next = Prev[static_cast<std::size_t>((Origin + Candidate) & (Window - 1))] - Origin;
+                        if (Next >= Candidate) { break; }
+                        Candidate = Next;
+                    }
+                }
+                if (Length >= MinMatch)
+                {
+                    PutLength(Length);
+                    PutDistance(Distance);
+                    int End = i + Length;
+                    if (Length > Lazy) { i = End - MinMatch; }
+                    for (; i < End; ++i) { Insert(Data, i, Size); }
+                }
+                else
+                {
+                    PutLiteral(Data[i]);
+                    Insert(Data, i, Size);
+                    ++i;
+                }
+            }
+            PutLiteral(256u);
+            if (Count > 0) { Put(0u, 8 - Count % 8); }
+            Put32(Adler(Data, Size));
+            Origin += Size;
+        };
+        void Insert(const std::uint8_t* Data, int i, int Size) &
+        {
+            if (i + MinMatch > Size) { return; }
+            std::uint32_t Hash = HashAt(Data + i);
+            Prev[static_cast<std::size_t>((Origin + i) & (Window - 1))] = Head[Hash];
+            Head[Hash] = Origin + i;
+        };
+        // Sums as the Adler-32 of zlib, taking the modulus only once for every 5552 bytes, the most that cannot
+        // overflow.
+        static std::uint32_t Adler(const std::uint8_t* Data, int Size)
+        {
+            std::uint32_t A = 1u;
+            std::uint32_t B = 0u;
+            for (int k = 0; k < Size;)
+            {
+                for (int End = (std::min)(Size, k + 5552); k < End; ++k)
+                {
+                    A += Data[k];
+                    B += A;
+                }
+                A %= 65521u;
+                B %= 65521u;
+            }
+            return B << 16 | A;
+        };
+        // Counts the bytes, up to Limit, where Older and Newer agree, 8 at a time.
+        static int Extend(const std::uint8_t* Older, const std::uint8_t* Newer, int Limit)
+        {
+            int Run = 0;
+            while (Run + 8 <= Limit)
+            {
+                std::uint64_t A = 0u;
+                std::uint64_t B = 0u;
+                std::memcpy(&A, Older + Run, 8u);
+                std::memcpy(&B, Newer + Run, 8u);
+                if (A != B) { return Run + std::countr_zero(A ^ B) / 8; }
+                Run += 8;
+            }
+            while (Run < Limit && Older[Run] == Newer[Run]) { ++Run; }
+            return Run;
+        };
+        static std::uint32_t HashAt(const std::uint8_t* At)
+        {
+            std::uint32_t Key = static_cast<std::uint32_t>(At[0]) | static_cast<std::uint32_t>(At[1]) << 8 | static_cast<std::uint32_t>(At[2]) << 16;
+            return Key * 0x9E3779B1u >> (32 - HashBits);
+        };
+        // Writes Length bits of Value from the least significant, and any whole bytes to Out.
+        void Put(std::uint32_t Value, int Length) &
+        {
+            Bits |= static_cast<std::uint64_t>(Value) << Count;
+            Count += Length;
+            while (Count >= 8)
+            {
+                Out.push_back(static_cast<std::uint8_t>(Bits));
+                Bits >>= 8;
+                Count -= 8;
+            }
+        };
+        void PutLiteral(std::uint32_t Value) &
+        {
+            Put(Literals[Value] >> 4, static_cast<int>(Literals[Value] & Nibble));
+        };
+        void PutLength(int Length) &
+        {
+            int Code = 28;
+            while (LengthBase[Code] > Length) { --Code; }
+            PutLiteral(257u + static_cast<std::uint32_t>(Code));
+            Put(static_cast<std::uint32_t>(Length - LengthBase[Code]), LengthExtra[Code]);
+        };
+        void PutDistance(int Distance) &
+        {
+            int Code = 29;
+            while (DistanceBase[Code] > Distance) { --Code; }
+            Put(Reverse(static_cast<std::uint32_t>(Code), 5), 5);
+            Put(static_cast<std::uint32_t>(Distance - DistanceBase[Code]), DistanceExtra[Code]);
+        };
+        std::size_t Begin(const char* Type) &
+        {
+            std::size_t At = Out.size();
+            Put32(0u);
+            Out.insert(Out.end(), Type, Type + 4);
+            return At;
+        };
+        // Fills in the length of the chunk begun at At and appends its CRC over the type and the data.
+        void End(std::size_t At) &
+        {
+            std::uint32_t Length = static_cast<std::uint32_t>(Out.size() - At - 8u);
+            for (int k = 0; k < 4; ++k) { Out[At + static_cast<std::size_t>(k)] = static_cast<std::uint8_t>(Length >> (24 - 8 * k)); }
+            std::uint32_t Crc = 0xFFFFFFFFu;
+            for (std::size_t k = At + 4u; k < Out.size(); ++k) { Crc = CrcTable[(Crc ^ Out[k]) & 255u] ^ (Crc >> 8); }
+            Put32(Crc ^ 0xFFFFFFFFu);
+        };
+        void Put32(std::uint32_t Value) &
+        {
+            for (int k = 0; k < 4; ++k) { Out.push_back(static_cast<std::uint8_t>(Value >> (24 - 8 * k))); }
+        };
+#pragma endregion
+    };
+#pragma region global-initializes
+    inline constexpr const std::array<std::uint32_t, 256> Png::CrcTable = Png::Crcs();
+    inline constexpr const std::array<std::uint32_t, 288> Png::Literals = Png::Codes();
+#pragma endregion
+}
@@ -29,21 +29,15 @@
 #include <cstdint>
 #include <Windows.h>
 #include <gdiplus.h>
+#include "Referee.h"
+#include "Renderer.h"
 namespace Gomoku
 {
     class MainWindow
     {
     public:
-        class Params
+        class Params : public Layout
         {
-        private:
-            static constexpr const int DefBp = 80;
-            static constexpr const int DefLw = 3;
-            static constexpr const int DefGs = 40;
-            static constexpr const float DefCSiz = 0.75F;
-            static constexpr const float DefCTou = 0.9F;
-            static constexpr const float DefCSha = 1.125F;
-            static constexpr const float DefCMar = 0.375F;
         public:
             static const Params Default;
             static constexpr const wchar_t Game[] = L"Gomoku";
@@ -51,123 +45,17 @@ namespace Gomoku
             static constexpr const wchar_t Lost[] = L"Gomoku - White Win";
             static constexpr const wchar_t Tied[] = L"Gomoku - Tied";
             static constexpr const wchar_t Reset[] = L"Reset";
-            static const Gdiplus::Color BoardColor;
-            static const Gdiplus::Color LineColor;
-            static const Gdiplus::Color ShadowColor;
-            static const Gdiplus::Color BlackChessLightColor;
-            static const Gdiplus::Color BlackChessDarkColor;
-            static const Gdiplus::Color WhiteChessLightColor;
-            static const Gdiplus::Color WhiteChessDarkColor;
             static const Gdiplus::GdiplusStartupInput StartupInput;
-        private:
-            int Bp;
-            int Lw;
-            int Gs;
-            float CSiz;
-            float CTou;
-            float CSha;
-            float CMar;
-        public:
-            constexpr int BoardPadding() const&
-            {
-                return Bp;
-            };
-            constexpr int LineWeight() const&
-            {
-                return Lw;
-            };
-            constexpr int GridSize() const&
-            {
-                return Gs;
-            };
-            constexpr float ChessSizeScale() const&
-            {
-                return CSiz;
-            };
-            constexpr float ChessTouchScale() const&
-            {
-                return CTou;
-            };
-            constexpr float ChessShadowScale() const&
-            {
-                return CSha;
-            };
-            constexpr float ChessMarginScale() const&
-            {
-                return CMar;
-            };
             constexpr Params()
-                : Bp{ DefBp }, Lw{ DefLw }, Gs{ DefGs }, CSiz{ DefCSiz }, CTou{ DefCTou }, CSha{ DefCSha }, CMar{ DefCMar }
+                : Layout{}
             {};
-            constexpr bool SetParams(int BoardPadding, int LineWeight, int GridSize)&
-            {
-                if (LineWeight >= GridSize) { return false; }
-                else if (GridSize >= BoardPadding) { return false; }
-                else if (BoardPadding <= 0) { return false; }
-                Bp = BoardPadding;
-                Lw = LineWeight;
-                Gs = GridSize;
-                return true;
-            };
-            constexpr bool SetScales(float ChessSizeScale, float ChessTouchScale, float ChessShadowScale, float ChessMarginScale)&
-            {
-                if (ChessSizeScale <= 0 || ChessSizeScale > 1) { return false; }
-                else if (ChessTouchScale <= 0 || ChessTouchScale > 1) { return false; }
-                else if (ChessShadowScale <= 0 || ChessShadowScale > 1) { return false; }
-                else if (ChessMarginScale <= 0 || ChessMarginScale > 1) { return false; }
-                CSiz = ChessSizeScale;
-                CTou = ChessTouchScale;
-                CSha = ChessShadowScale;
-                CMar = ChessMarginScale;
-                return true;
-            };
-            constexpr int BoardOuterSize() const&
-            {
-                return Bp * 2 + Lw * 15 + Gs * 14;
-            };
-            constexpr int BoardInnerSize() const&
-            {
-                return Lw * 15 + Gs * 14;
-            };
-            constexpr int GsScaleToLw(float C) const&
-            {
-                int Result = static_cast<int>(Gs * C);
-                return Lw % 2 == Result % 2 ? Result : Result + 1;
-            };
-            constexpr int ChessSize() const&
-            {
-                return GsScaleToLw(CSiz);
-            };
-            constexpr int ChessTouch() const&
-            {
-                return GsScaleToLw(CTou);
-            };
-            constexpr int ChessShadow() const&
-            {
-                return GsScaleToLw(CSha);
-            };
-            constexpr int ChessMargin() const&
-            {
-                return GsScaleToLw(CMar);
-            };
         };
     private:
-		using Result = std::uint32_t;
-        struct Position
-        {
-        private:
-            std::uint32_t Coord;
-        };
-        struct Board
-        {
-        private:
-            std::uint32_t Grid[15];
-            std::uint8_t Round;
-		};
         const Params* Pa;
         Position Po;
         Result Re;
         Board Bo;
+        BoardRenderer Rd;
         UINT BtnReset;
         ULONG_PTR Gdiplus;
         HWND Window;
@@ -0,0 +1,287 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Evaluator.h"
+#include "MoveGenerator.h"
+#include "Referee.h"
+namespace Gomoku
+{
+    // Proves forced wins by proof-number search, where the attacker plays a five, the block of a five, or a
+    // four or an open three, but the defender may answer at any point it is allowed to, so that unlike the
+    // Solver a proven win holds against every defence under the rules of the BasicReferee, the forbidden
+    // points of Black by the S3Forbid included. A position not proven is only not known within the limits.
+    class ProofSearch
+    {
+#pragma region constants
+    public:
+        static constexpr const std::uint32_t Infinity = 0x3FFFFFFFu;
+#pragma endregion
+#pragma region helper-classes
+    public:
+        enum struct Outcome : std::uint8_t
+        {
+            Unknown = 0u,
+            Win = 1u,
+            Loss = 2u,
+        };
+        struct Stats
+        {
+        public:
+            std::uint64_t Nodes;
+            std::uint64_t Expansions;
+            std::chrono::nanoseconds Elapsed;
+            constexpr Stats()
+                : Nodes{ 0u }, Expansions{ 0u }, Elapsed{ 0 }
+            {};
+            constexpr double NodesPerSecond() const &
+            {
+                return Elapsed.count() > 0 ? Nodes * 1e9 / Elapsed.count() : 0e0;
+            };
+        };
+    private:
+        struct Node
+        {
+        public:
+            std::uint32_t Proof;
+            std::uint32_t Disproof;
+            std::uint32_t First;
+            std::uint8_t Count;
+            std::uint8_t Move;
+            bool Expanded;
+            constexpr Node(std::uint8_t Move)
+                : Proof{ 1u }, Disproof{ 1u }, First{ 0u }, Count{ 0u }, Move{ Move }, Expanded{ false }
+            {};
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        std::vector<Node> Nodes;
+        std::size_t Capacity;
+        LineBoard Root;
+        bool Attacker;
+        int Limit;
+        bool Exhausted;
+        Stats St;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit ProofSearch(std::size_t Capacity = 1u << 20)
+            : Nodes{}, Capacity{ Capacity }, Root{}, Attacker{ true }, Limit{ 0 }, Exhausted{ false }, St{}
+        {
+            Nodes.reserve(Capacity);
+        };
+        const Stats& LastStats() const &
+        {
+            return St;
+        };
+        // Deepens the moves of the attacker from 1 to Depth, trying a win of the side to move and then a win
+        // of the other side at each, and stops at the first proof or when the nodes run out. Move is the first
+        // move of a win, and Length the moves of the winner up to its five.
+        Outcome Solve(const Board& Bo, int Depth, Position& Move, int& Length) &
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            St = Stats{};
+            Exhausted = false;
+            Outcome Ou = Outcome::Unknown;
+            Move = Position::Null;
+            Length = 0;
+            for (int d = 1; d <= std::min(Depth, 112) && Ou == Outcome::Unknown && !Exhausted; ++d)
+            {
+                if (Prove(Bo, Bo.IsBlackTurn(), d, Move)) { Ou = Outcome::Win; }
+                else if (!Exhausted && Prove(Bo, !Bo.IsBlackTurn(), d, Move)) { Ou = Outcome::Loss; }
+                if (Ou != Outcome::Unknown) { Length = d; }
+            }
+            if (Ou != Outcome::Win) { Move = Position::Null; }
+            St.Elapsed = std::chrono::steady_clock::now() - Begin;
+            return Ou;
+        };
+        // Returns whether Black, or White, wins Bo within Depth moves of its own whichever side is to move,
+        // and the first move of the side to move on the proof.
+        bool Prove(const Board& Bo, bool Black, int Depth, Position& Move) &
+        {
+            Move = Position::Null;
+            if (Bo.IsPending() || Bo.IsEnded()) { return false; }
+            Nodes.clear();
+            Nodes.push_back(Node{ Byte });
+            Root = LineBoard{ Bo };
+            Attacker = Black;
+            Limit = Depth;
+            std::uint8_t Points[2]{};
+            if (Root.IsBlackTurn() == Attacker && Fives(Root, Attacker, Points) > 0)
+            {
+                Move = Position{ Points[0] };
+                return true;
+            }
+            std::uint32_t Path[226]{};
+            while (Nodes[0].Proof != 0u && Nodes[0].Disproof != 0u)
+            {
+                LineBoard Walk = Root;
+                int Length = 0;
+                int Attacks = 0;
+                std::uint32_t At = 0u;
+                while (Nodes[At].Expanded)
+                {
+                    Path[Length++] = At;
+                    bool Or = Walk.IsBlackTurn() == Attacker;
+                    const Node& No = Nodes[At];
+                    std::uint32_t Next = No.First;
+                    for (std::uint32_t i = No.First + 1u, E = No.First + No.Count; i < E; ++i)
+                    {
+                        if (Or ? Nodes[i].Proof < Nodes[Next].Proof : Nodes[i].Disproof < Nodes[Next].Disproof) { Next = i; }
+                    }
+                    if (Or) { ++Attacks; }
+                    Play(Walk, Position{ Nodes[Next].Move });
+                    At = Next;
+                }
+                Path[Length++] = At;
+                if (!Expand(At, Walk, Attacks))
+                {
+                    Exhausted = true;
+                    return false;
+                }
+                for (int i = Length - 1; i >= 0; --i) { Update(Nodes[Path[i]], (Root.IsBlackTurn() == Attacker) == (i % 2 == 0)); }
+            }
+            if (Nodes[0].Proof != 0u) { return false; }
+            for (std::uint32_t i = Nodes[0].First, E = Nodes[0].First + Nodes[0].Count; i < E && Root.IsBlackTurn() == Attacker; ++i)
+            {
+                if (Nodes[i].Proof == 0u)
+                {
+                    Move = Position{ Nodes[i].Move };
+                    break;
+                }
+            }
+            return true;
+        };
+    private:
+        static void Play(LineBoard& Bo, Position Po)
+        {
+            Bo[Po] = Bo.IsBlackTurn() ? Chess::Black : Chess::White;
+            ++Bo;
+        };
+        // Finds up to 2 points where Bk makes a five it is allowed to, all of which lie next to a Chess.
+        static int Fives(LineBoard& Bo, bool Bk, std::uint8_t (&Points)[2])
+        {
+            std::uint32_t Stones[15]{};
+            std::uint32_t Near[15]{};
+            MoveGenerator::Neighbours(Bo, 1, Stones, Near);
+            int Count = 0;
+            for (int Y = 0; Y < 15 && Count < 2; ++Y)
+            {
+                for (std::uint32_t Li = Near[Y]; Li != 0u && Count < 2; Li &= Li - 1u)
+                {
+                    Position Po{ std::countr_zero(Li), Y };
+                    bool Five = false;
+                    for (int Or = 0; Or < 4 && !Five; ++Or) { Five = Evaluator::Classify(Bo.GetLine(Po, static_cast<Orientation>(Or)), Bk) == Evaluator::Shape::Five; }
+                    if (Five && (!Bk || MoveGenerator::Allowed(Bo, Po))) { Points[Count++] = static_cast<std::uint8_t>(Po); }
+                }
+            }
+            return Count;
+        };
+        // Whether Bk makes a four or an open three by putting a Chess at Po.
+        static bool Forcing(const LineBoard& Bo, Position Po, bool Bk)
+        {
+            for (int Or = 0; Or < 4; ++Or)
+            {
+                Evaluator::Shape Sh = Evaluator::Classify(Bo.GetLine(Po, static_cast<Orientation>(Or)), Bk);
+                if (Sh == Evaluator::Shape::OpenThree || Sh >= Evaluator::Shape::ClosedFour) { return true; }
+            }
+            return false;
+        };
+        // Either settles the node at At, where Walk is its Board and Attacks the moves of the attacker so far,
+        // or gives it its children, which returns false when they do not fit in the Capacity.
+        bool Expand(std::uint32_t At, LineBoard& Walk, int Attacks) &
+        {
+            ++St.Expansions;
+            bool Bk = Walk.IsBlackTurn();
+            bool Or = Bk == Attacker;
+            std::uint8_t Points[2]{};
+            Node& No = Nodes[At];
+            No.Expanded = true;
+            if (Fives(Walk, Bk, Points) > 0) { return Settle(No, Or); }
+            int Theirs = Fives(Walk, !Bk, Points);
+            if (Walk.IsEnded()) { return Settle(No, false); }
+            if (Theirs >= 2 || (Or && Attacks + 2 > Limit)) { return Settle(No, !Or); }
+            MoveGenerator::Buffer Moves{};
+            int Count = 0;
+            if (Theirs == 1)
+            {
+                if (Bk && !MoveGenerator::Allowed(Walk, Position{ Points[0] })) { return Settle(No, !Or); }
+                Moves[Count++] = MoveGenerator::Move{ Position{ Points[0] }, MoveGenerator::Threat::BlockFive, 0 };
+            }
+            else if (Or)
+            {
+                int Total = MoveGenerator::Generate(Walk, Moves);
+                for (int i = 0; i < Total; ++i)
+                {
+                    if (Forcing(Walk, Moves[i].Po, Bk)) { Moves[Count++] = Moves[i]; }
+                }
+            }
+            else { Count = MoveGenerator::Generate(Walk, Moves, 15); }
+            if (Count == 0) { return Settle(No, !Or); }
+            if (Nodes.size() + static_cast<std::size_t>(Count) > Capacity) { return false; }
+            std::uint32_t First = static_cast<std::uint32_t>(Nodes.size());
+            for (int i = 0; i < Count; ++i) { Nodes.push_back(Node{ static_cast<std::uint8_t>(Moves[i].Po) }); }
+            St.Nodes += static_cast<std::uint64_t>(Count);
+            Node& Parent = Nodes[At];
+            Parent.First = First;
+            Parent.Count = static_cast<std::uint8_t>(Count);
+            return true;
+        };
+        // Marks No proven for the attacker, or disproven when not Proven.
+        static bool Settle(Node& No, bool Proven)
+        {
+            No.Proof = Proven ? 0u : Infinity;
+            No.Disproof = Proven ? Infinity : 0u;
+            return true;
+        };
+        void Update(Node& No, bool Or) &
+        {
+            if (No.Count == 0u) { return; }
+            std::uint32_t Least = Infinity;
+            std::uint32_t Sum = 0u;
+            for (std::uint32_t i = No.First, E = No.First + No.Count; i < E; ++i)
+            {
+                const Node& Child = Nodes[i];
+                std::uint32_t Minor = Or ? Child.Proof : Child.Disproof;
+                std::uint32_t Major = Or ? Child.Disproof : Child.Proof;
+                Least = std::min(Least, Minor);
+                Sum = std::min(Sum + Major, Infinity);
+            }
+            No.Proof = Or ? Least : Sum;
+            No.Disproof = Or ? Sum : Least;
+        };
+#pragma endregion
+    };
+}
@@ -0,0 +1,273 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+namespace Gomoku
+{
+    // A Color is 0xAARRGGBB as the Gdiplus.Color takes it, with straight alpha.
+    using Color = std::uint32_t;
+    struct Point
+    {
+    public:
+        int X;
+        int Y;
+    };
+    struct Rect
+    {
+    public:
+        int X;
+        int Y;
+        int Width;
+        int Height;
+        constexpr int Right() const &
+        {
+            return X + Width;
+        };
+        constexpr int Bottom() const &
+        {
+            return Y + Height;
+        };
+        constexpr bool Empty() const &
+        {
+            return Width <= 0 || Height <= 0;
+        };
+        constexpr Rect Union(const Rect& Re) const &
+        {
+            if (Empty()) { return Re; }
+            else if (Re.Empty()) { return *this; }
+            int Left = (std::min)(X, Re.X);
+            int Top = (std::min)(Y, Re.Y);
+            return Rect{ Left, Top, (std::max)(Right(), Re.Right()) - Left, (std::max)(Bottom(), Re.Bottom()) - Top };
+        };
+        constexpr Rect Intersect(const Rect& Re) const &
+        {
+            int Left = (std::max)(X, Re.X);
+            int Top = (std::max)(Y, Re.Y);
+            int W = (std::min)(Right(), Re.Right()) - Left;
+            int H = (std::min)(Bottom(), Re.Bottom()) - Top;
+            if (W <= 0 || H <= 0) { return Rect{ 0, 0, 0, 0 }; }
+            return Rect{ Left, Top, W, H };
+        };
+    };
+    // The primitives which the BoardRenderer draws with, so that the same drawing goes to a Gdiplus.Bitmap in
+    // the window and to a Bitmap in memory anywhere else.
+    class RasterTarget
+    {
+    public:
+        virtual ~RasterTarget() = default;
+        virtual int Width() const & = 0;
+        virtual int Height() const & = 0;
+        virtual void Clear(Color Co) & = 0;
+        virtual void FillRect(const Rect& Re, Color Co) & = 0;
+        virtual void FillEllipse(const Rect& Re, Color Co) & = 0;
+        // Fills the ellipse in Re where it overlaps the ellipse in Path, from Centre at the centre of Path to
+        // Surround on its edge, as a PathGradientBrush of one surround colour does.
+        virtual void FillGradient(const Rect& Re, const Rect& Path, Color Centre, Color Surround) & = 0;
+        // Composites From of Source over this target at X and Y, where Source shall come from the Offscreen of a
+        // target of the same kind.
+        virtual void Draw(const RasterTarget& Source, const Rect& From, int X, int Y) & = 0;
+        virtual std::unique_ptr<RasterTarget> Offscreen(int Width, int Height) const & = 0;
+    };
+    // A RasterTarget in memory with premultiplied 0xAARRGGBB pixels, where every ellipse is antialiased by 16
+    // samples for each pixel. A Bitmap cleared to an opaque Color stays opaque, since everything else composites
+    // over it, and is drawn by copying its rows.
+    class Bitmap final : public RasterTarget
+    {
+#pragma region fields
+    private:
+        int W;
+        int H;
+        std::vector<std::uint32_t> Pixels;
+        bool Opaque;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        Bitmap(int Width, int Height)
+            : W{ (std::max)(Width, 0) }, H{ (std::max)(Height, 0) }, Pixels(static_cast<std::size_t>((std::max)(Width, 0)) * static_cast<std::size_t>((std::max)(Height, 0)), 0u), Opaque{ false }
+        {};
+        int Width() const & override
+        {
+            return W;
+        };
+        int Height() const & override
+        {
+            return H;
+        };
+        const std::uint32_t* Row(int Y) const &
+        {
+            return Pixels.data() + static_cast<std::size_t>(Y) * static_cast<std::size_t>(W);
+        };
+        std::uint32_t* Row(int Y) &
+        {
+            return Pixels.data() + static_cast<std::size_t>(Y) * static_cast<std::size_t>(W);
+        };
+        void Clear(Color Co) & override
+        {
+            std::fill(Pixels.begin(), Pixels.end(), Premultiply(Co));
+            Opaque = Co >> 24 == 255u;
+        };
+        void FillRect(const Rect& Re, Color Co) & override
+        {
+            Rect Cl = Re.Intersect(Bounds());
+            std::uint32_t Pr = Premultiply(Co);
+            for (int Y = Cl.Y; Y < Cl.Bottom(); ++Y)
+            {
+                std::uint32_t* Ro = Row(Y);
+                for (int X = Cl.X; X < Cl.Right(); ++X) { Ro[X] = Over(Pr, Ro[X]); }
+            }
+        };
+        void FillEllipse(const Rect& Re, Color Co) & override
+        {
+            Rect Cl = Re.Intersect(Bounds());
+            std::uint32_t Pr = Premultiply(Co);
+            for (int Y = Cl.Y; Y < Cl.Bottom(); ++Y)
+            {
+                std::uint32_t* Ro = Row(Y);
+                for (int X = Cl.X; X < Cl.Right(); ++X)
+                {
+                    std::uint32_t Cover = Coverage(Re, X, Y);
+                    if (Cover > 0u) { Ro[X] = Over(Scale(Pr, Cover * 16u), Ro[X]); }
+                }
+            }
+        };
+        void FillGradient(const Rect& Re, const Rect& Path, Color Centre, Color Surround) & override
+        {
+            Rect Cl = Re.Intersect(Path).Intersect(Bounds());
+            double Cx = Path.X + Path.Width / 2e0;
+            double Cy = Path.Y + Path.Height / 2e0;
+            for (int Y = Cl.Y; Y < Cl.Bottom(); ++Y)
+            {
+                std::uint32_t* Ro = Row(Y);
+                for (int X = Cl.X; X < Cl.Right(); ++X)
+                {
+                    std::uint32_t Cover = (std::min)(Coverage(Re, X, Y), Coverage(Path, X, Y));
+                    if (Cover == 0u) { continue; }
+                    double Dx = (X + 0.5 - Cx) / (Path.Width / 2e0);
+                    double Dy = (Y + 0.5 - Cy) / (Path.Height / 2e0);
+                    double T = (std::min)(std::sqrt(Dx * Dx + Dy * Dy), 1e0);
+                    Ro[X] = Over(Scale(Premultiply(Mix(Centre, Surround, static_cast<std::uint32_t>(T * 256e0))), Cover * 16u), Ro[X]);
+                }
+            }
+        };
+        void Draw(const RasterTarget& Source, const Rect& From, int X, int Y) & override
+        {
+            const Bitmap& So = static_cast<const Bitmap&>(Source);
+            int Dx = From.X - X;
+            int Dy = From.Y - Y;
+            Rect Fr = From.Intersect(So.Bounds());
+            Rect To = Rect{ Fr.X - Dx, Fr.Y - Dy, Fr.Width, Fr.Height }.Intersect(Bounds());
+            for (int Ty = To.Y; Ty < To.Bottom(); ++Ty)
+            {
+                const std::uint32_t* Src = So.Row(Ty + Dy) + Dx;
+                std::uint32_t* Dst = Row(Ty);
+                if (So.Opaque)
+                {
+                    std::copy(Src + To.X, Src + To.Right(), Dst + To.X);
+                    continue;
+                }
+                for (int Tx = To.X; Tx < To.Right(); ++Tx) { Dst[Tx] = Over(Src[Tx], Dst[Tx]); }
+            }
+        };
+        std::unique_ptr<RasterTarget> Offscreen(int Width, int Height) const & override
+        {
+            return std::make_unique<Bitmap>(Width, Height);
+        };
+        constexpr Rect Bounds() const &
+        {
+            return Rect{ 0, 0, W, H };
+        };
+        static constexpr std::uint32_t Premultiply(Color Co)
+        {
+            std::uint32_t A = Co >> 24;
+            if (A == 255u) { return Co; }
+            std::uint32_t R = ((Co >> 16 & 255u) * A + 127u) / 255u;
+            std::uint32_t G = ((Co >> 8 & 255u) * A + 127u) / 255u;
+            std::uint32_t B = ((Co & 255u) * A + 127u) / 255u;
+            return A << 24 | R << 16 | G << 8 | B;
+        };
+        // Composites the premultiplied Src over Dst, two channels at a time.
+        static constexpr std::uint32_t Over(std::uint32_t Src, std::uint32_t Dst)
+        {
+            std::uint32_t A = Src >> 24;
+            if (A == 255u) { return Src; }
+            else if (A == 0u) { return Dst; }
+            std::uint32_t Inverse = 255u - A;
+            std::uint32_t Rb = (Dst & 0x00FF00FFu) * Inverse + 0x00800080u;
+            std::uint32_t Ag = (Dst >> 8 & 0x00FF00FFu) * Inverse + 0x00800080u;
+            Rb = (Rb + (Rb >> 8 & 0x00FF00FFu)) >> 8 & 0x00FF00FFu;
+            Ag = (Ag + (Ag >> 8 & 0x00FF00FFu)) >> 8 & 0x00FF00FFu;
+            return Src + (Rb | Ag << 8);
+        };
+    private:
+        // Scales a premultiplied pixel by F of 256.
+        static constexpr std::uint32_t Scale(std::uint32_t Px, std::uint32_t F)
+        {
+            std::uint32_t Rb = (Px & 0x00FF00FFu) * F >> 8 & 0x00FF00FFu;
+            std::uint32_t Ag = (Px >> 8 & 0x00FF00FFu) * F >> 8 & 0x00FF00FFu;
+            return Rb | Ag << 8;
+        };
+        // Mixes two straight colours by T of 256 from First to Second.
+        static constexpr Color Mix(Color First, Color Second, std::uint32_t T)
+        {
+            Color Result = 0u;
+            for (int Shift = 0; Shift < 32; Shift += 8)
+            {
+                std::uint32_t A = First >> Shift & 255u;
+                std::uint32_t B = Second >> Shift & 255u;
+                Result |= (A * (256u - T) + B * T) >> 8 << Shift;
+            }
+            return Result;
+        };
+        // Counts the samples of the pixel at X and Y, 4 by 4, inside the ellipse in Re.
+        static std::uint32_t Coverage(const Rect& Re, int X, int Y)
+        {
+            double Rx = Re.Width / 2e0;
+            double Ry = Re.Height / 2e0;
+            double Cx = Re.X + Rx;
+            double Cy = Re.Y + Ry;
+            std::uint32_t Count = 0u;
+            for (int j = 0; j < 4; ++j)
+            {
+                double Dy = (Y + (j + 0.5) / 4e0 - Cy) / Ry;
+                for (int i = 0; i < 4; ++i)
+                {
+                    double Dx = (X + (i + 0.5) / 4e0 - Cx) / Rx;
+                    if (Dx * Dx + Dy * Dy <= 1e0) { ++Count; }
+                }
+            }
+            return Count;
+        };
+#pragma endregion
+    };
+}
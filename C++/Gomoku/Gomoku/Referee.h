@@ -0,0 +1,1118 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Instrument.h"
+namespace Gomoku
+{
+#pragma region constants
+    inline constexpr const std::uint32_t Byte = 0xFFu;
+    inline constexpr const std::uint32_t Nibble = 0xFu;
+    inline constexpr const std::uint32_t Box = 0b11u;
+    inline constexpr const std::uint32_t Bit = 0b1u;
+#pragma endregion
+#pragma region enumerations
+    enum struct Result : std::uint32_t
+    {
+        None = 0u,
+        Won = 1u,
+        Lost = 2u,
+        Tied = 3u,
+    };
+    enum struct Chess : std::uint32_t
+    {
+        None = 0u,
+        Black = 1u,
+        White = 2u,
+        Unspecified = 3u,
+    };
+    enum struct Player : std::uint32_t
+    {
+        Unknown = 0u,
+        Attacker = 1u,
+        Defender = 2u,
+        Empty = 3u,
+    };
+    enum struct Orientation : std::uint32_t
+    {
+        Horizontal = 0u,
+        Vertical = 1u,
+        Downward = 2u,
+        Upward = 3u,
+    };
+    enum struct Forbidden : std::uint32_t
+    {
+        None = 0u,
+        ThreeThree = 1u,
+        FourFour = 2u,
+        Overline = 3u,
+    };
+#pragma endregion
+#pragma region helper-classes
+    struct Position
+    {
+    public:
+        static const Position Null;
+    private:
+        std::uint32_t Coord;
+    public:
+        constexpr int X() const &
+        {
+            return static_cast<int>(Coord & Nibble);
+        };
+        constexpr void X(int value) &
+        {
+            Coord &= ~Nibble;
+            Coord |= static_cast<std::uint32_t>(value) & Nibble;
+        };
+        constexpr int Y() const &
+        {
+            return static_cast<int>((Coord >> 4) & Nibble);
+        };
+        constexpr void Y(int value) &
+        {
+            Coord &= ~(Nibble << 4);
+            Coord |= (static_cast<std::uint32_t>(value) & Nibble) << 4;
+        };
+        constexpr explicit Position(std::uint8_t B)
+            : Coord{ B }
+        {};
+        constexpr Position(int X, int Y)
+            : Coord{ 0u }
+        {
+            this->X(X);
+            this->Y(Y);
+        };
+        constexpr explicit operator std::uint8_t() const
+        {
+            return static_cast<std::uint8_t>(Coord & Byte);
+        };
+        constexpr explicit operator std::uint16_t() const
+        {
+            return static_cast<std::uint16_t>(Coord & Byte);
+        };
+        constexpr explicit operator std::uint32_t() const
+        {
+            return static_cast<std::uint32_t>(Coord & Byte);
+        };
+        constexpr explicit operator std::uint64_t() const
+        {
+            return static_cast<std::uint64_t>(Coord & Byte);
+        };
+        friend constexpr bool operator ==(Position L, Position R)
+        {
+            return L.Coord == R.Coord;
+        };
+        friend constexpr bool operator !=(Position L, Position R)
+        {
+            return L.Coord != R.Coord;
+        };
+    };
+    struct Zobrist
+    {
+    public:
+        static const std::array<std::uint64_t, 512> Keys;
+        static constexpr std::uint64_t Key(Position Po, Chess Ch)
+        {
+            if (Ch != Chess::Black && Ch != Chess::White) { return 0u; }
+            return Keys[(static_cast<std::uint32_t>(Po) << 1) | (static_cast<std::uint32_t>(Ch) - 1u)];
+        };
+        static constexpr std::array<std::uint64_t, 512> Tabulate()
+        {
+            std::array<std::uint64_t, 512> Result{};
+            std::uint64_t Seed = 0x9E3779B97F4A7C15ull;
+            for (std::uint64_t& Ke : Result)
+            {
+                Seed += 0x9E3779B97F4A7C15ull;
+                std::uint64_t Mix = Seed;
+                Mix = (Mix ^ (Mix >> 30)) * 0xBF58476D1CE4E5B9ull;
+                Mix = (Mix ^ (Mix >> 27)) * 0x94D049BB133111EBull;
+                Ke = Mix ^ (Mix >> 31);
+            }
+            return Result;
+        };
+    };
+    struct Board
+    {
+    public:
+        struct ChessCRef
+        {
+        public:
+            friend struct Board;
+        private:
+            const std::uint32_t* Grid;
+            Position Po;
+            constexpr explicit ChessCRef(const std::uint32_t* Grid, Position Po)
+                : Grid{ Grid }, Po{ Po }
+            {};
+        public:
+            constexpr operator Chess() const
+            {
+                int PoX = Po.X();
+                int PoY = Po.Y();
+                if (PoX == 15 || PoY == 15) { return Chess::Unspecified; }
+                int Shift = PoX * 2;
+                return static_cast<Chess>((Grid[PoY] >> Shift) & Box);
+            };
+            constexpr Position Pos() const
+            {
+                return Po;
+            };
+        };
+        struct ChessRef
+        {
+        public:
+            friend struct Board;
+        private:
+            std::uint32_t* Grid;
+            std::uint64_t* Hash;
+            Position Po;
+            constexpr explicit ChessRef(std::uint32_t* Grid, std::uint64_t* Hash, Position Po)
+                : Grid{ Grid }, Hash{ Hash }, Po{ Po }
+            {};
+        public:
+            constexpr operator ChessCRef()
+            {
+                return ChessCRef{ Grid, Po };
+            };
+            constexpr operator Chess() const
+            {
+                int PoX = Po.X();
+                int PoY = Po.Y();
+                if (PoX == 15 || PoY == 15) { return Chess::Unspecified; }
+                int Shift = PoX * 2;
+                return static_cast<Chess>((Grid[PoY] >> Shift) & Box);
+            };
+            constexpr void operator =(Chess value) const
+            {
+                int PoX = Po.X();
+                int PoY = Po.Y();
+                if (PoX == 15 || PoY == 15) { return; }
+                int Shift = PoX * 2;
+                *Hash ^= Zobrist::Key(Po, static_cast<Chess>((Grid[PoY] >> Shift) & Box)) ^ Zobrist::Key(Po, value);
+                Grid[PoY] &= ~(Box << Shift);
+                Grid[PoY] |= (static_cast<std::uint32_t>(value) & Box) << Shift;
+            };
+            constexpr Position Pos() const
+            {
+                return Po;
+            };
+        };
+        struct ChessCIte
+        {
+        public:
+            friend struct Board;
+        private:
+            const std::uint32_t* Grid;
+            int Index;
+            constexpr explicit ChessCIte(const std::uint32_t* Grid, int Index)
+                : Grid{ Grid }, Index{ Index }
+            {};
+        public:
+            constexpr ChessCIte& operator ++()
+            {
+                ++Index;
+                return *this;
+            };
+            constexpr ChessCIte operator ++(int)
+            {
+                ChessCIte Result = *this;
+                ++Index;
+                return Result;
+            };
+            constexpr ChessCRef operator *() const
+            {
+                return ChessCRef{ Grid, Position{ Index % 15, Index / 15 } };
+            };
+            friend constexpr bool operator ==(const ChessCIte& L, const ChessCIte& R)
+            {
+                return L.Grid == R.Grid && L.Index == R.Index;
+            };
+            friend constexpr bool operator !=(const ChessCIte& L, const ChessCIte& R)
+            {
+                return L.Grid != R.Grid || L.Index != R.Index;
+            };
+        };
+        struct ChessIte
+        {
+        public:
+            friend struct Board;
+        private:
+            std::uint32_t* Grid;
+            std::uint64_t* Hash;
+            int Index;
+            constexpr explicit ChessIte(std::uint32_t* Grid, std::uint64_t* Hash, int Index)
+                : Grid{ Grid }, Hash{ Hash }, Index{ Index }
+            {};
+        public:
+            constexpr operator ChessCIte() const
+            {
+                return ChessCIte{ Grid, Index };
+            };
+            constexpr ChessIte& operator ++()
+            {
+                ++Index;
+                return *this;
+            };
+            constexpr ChessIte operator ++(int)
+            {
+                ChessIte Result = *this;
+                ++Index;
+                return Result;
+            };
+            constexpr ChessRef operator *() const
+            {
+                return ChessRef{ Grid, Hash, Position{ Index % 15, Index / 15 } };
+            };
+            friend constexpr bool operator ==(const ChessIte& L, const ChessIte& R)
+            {
+                return L.Grid == R.Grid && L.Index == R.Index;
+            };
+            friend constexpr bool operator !=(const ChessIte& L, const ChessIte& R)
+            {
+                return L.Grid != R.Grid || L.Index != R.Index;
+            };
+        };
+    private:
+        std::uint32_t Grid[15];
+        std::uint8_t Round;
+        std::uint64_t Key;
+    public:
+        constexpr Board()
+            : Grid{}, Round{ 0u }, Key{ 0u }
+        {};
+        constexpr void Reset() &
+        {
+            for (std::uint32_t& Li : Grid) { Li = 0; }
+            Round = 0;
+            Key = 0u;
+        };
+        constexpr std::uint64_t Hash() const &
+        {
+            return Key;
+        };
+        constexpr int Rounds() const &
+        {
+            return Round;
+        };
+        constexpr ChessCRef operator[](Position Po) const &
+        {
+            return ChessCRef{ Grid, Po };
+        };
+        constexpr ChessRef operator[](Position Po) &
+        {
+            return ChessRef{ Grid, &Key, Po };
+        };
+        constexpr ChessCIte begin() const &
+        {
+            return ChessCIte{ Grid, 0 };
+        };
+        constexpr ChessIte begin() &
+        {
+            return ChessIte{ Grid, &Key, 0 };
+        };
+        constexpr ChessCIte end() const &
+        {
+            return ChessCIte{ Grid, 225 };
+        };
+        constexpr ChessIte end() &
+        {
+            return ChessIte{ Grid, &Key, 225 };
+        };
+        constexpr std::uint32_t GetLine(Position Po, Orientation Or) const &
+        {
+            GOMOKU_COUNT(GetLine);
+            std::uint32_t Result = 0u;
+            int PoX = Po.X();
+            int PoY = Po.Y();
+            int ShiftX = PoX * 2;
+            if (Or == Orientation::Horizontal)
+            {
+                std::uint64_t Row = static_cast<std::uint64_t>(Grid[PoY]) | ~0x3FFFFFFFull;
+                Row = (Row << 8) | Byte;
+                Result = static_cast<std::uint32_t>(Row >> ShiftX) & 0x3FFFFu;
+            }
+            else
+            {
+                int ShiftR = 0;
+                int Step = 0;
+                if (Or == Orientation::Downward)
+                {
+                    ShiftX -= 8;
+                    Step = 2;
+                }
+                else if (Or == Orientation::Upward)
+                {
+                    ShiftX += 8;
+                    Step = -2;
+                }
+                for (int Y = PoY - 4, E = PoY + 4; Y <= E; ++Y)
+                {
+                    if (Y < 0 || Y > 14 || ShiftX < 0 || ShiftX > 28) { Result |= Box << ShiftR; }
+                    else { Result |= ((Grid[Y] >> ShiftX) & Box) << ShiftR; }
+                    ShiftX += Step;
+                    ShiftR += 2;
+                }
+            }
+            Result |= static_cast<std::uint32_t>(Or) << 30;
+            Result |= 0x3FFC0000u;
+            return Result;
+        };
+        constexpr Board& operator ++()
+        {
+            if (Round < 225) { ++Round; }
+            return *this;
+        };
+        constexpr Board& operator ++(int) = delete;
+        // Takes back a round, after the Chess put in it has been taken off.
+        constexpr Board& operator --()
+        {
+            if (Round > 0) { --Round; }
+            return *this;
+        };
+        constexpr Board& operator --(int) = delete;
+        constexpr bool IsBlackTurn() const &
+        {
+            return Round % 2 == 0;
+        };
+        constexpr bool IsPending() const &
+        {
+            return Round == 0;
+        };
+        constexpr bool IsEnded() const &
+        {
+            return Round == 225;
+        };
+        constexpr bool CanPutChess(Position Po) const &
+        {
+            if (IsEnded()) { return false; }
+            int PoX = Po.X();
+            int PoY = Po.Y();
+            if (IsPending() && !(PoX == 7 && PoY == 7)) { return false; }
+            return operator[](Po) == Chess::None;
+        };
+    };
+    struct LineBoard
+    {
+    public:
+        struct ChessRef
+        {
+        public:
+            friend struct LineBoard;
+        private:
+            LineBoard* Ow;
+            Position Po;
+            constexpr explicit ChessRef(LineBoard* Ow, Position Po)
+                : Ow{ Ow }, Po{ Po }
+            {};
+            static constexpr void Put(std::uint64_t& Li, int Index, Chess value)
+            {
+                int Shift = Index * 2 + 8;
+                Li &= ~(static_cast<std::uint64_t>(Box) << Shift);
+                Li |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(value) & Box) << Shift;
+            };
+        public:
+            constexpr operator Board::ChessCRef() const
+            {
+                return static_cast<const Board&>(Ow->Bo)[Po];
+            };
+            constexpr operator Chess() const
+            {
+                return static_cast<const Board&>(Ow->Bo)[Po];
+            };
+            constexpr void operator =(Chess value) const
+            {
+                int PoX = Po.X();
+                int PoY = Po.Y();
+                if (PoX == 15 || PoY == 15) { return; }
+                Ow->Bo[Po] = value;
+                Put(Ow->Rows[PoY], PoX, value);
+                Put(Ow->Cols[PoX], PoY, value);
+                Put(Ow->Downs[PoX - PoY + 14], PoY, value);
+                Put(Ow->Ups[PoX + PoY], PoY, value);
+            };
+            constexpr Position Pos() const
+            {
+                return Po;
+            };
+        };
+    private:
+        Board Bo;
+        std::uint64_t Rows[15];
+        std::uint64_t Cols[15];
+        std::uint64_t Downs[29];
+        std::uint64_t Ups[29];
+        static constexpr std::uint64_t Blank(int First, int Last)
+        {
+            std::uint64_t Result = ~0ull;
+            for (int i = First; i <= Last; ++i) { Result &= ~(static_cast<std::uint64_t>(Box) << (i * 2 + 8)); }
+            return Result;
+        };
+    public:
+        constexpr LineBoard()
+            : Bo{}, Rows{}, Cols{}, Downs{}, Ups{}
+        {
+            Reset();
+        };
+        constexpr explicit LineBoard(const Board& Source)
+            : LineBoard{}
+        {
+            for (Board::ChessCRef Ch : Source)
+            {
+                if (Ch != Chess::None) { operator[](Ch.Pos()) = Ch; }
+            }
+            Bo = Source;
+        };
+        constexpr void Reset() &
+        {
+            Bo.Reset();
+            for (std::uint64_t& Li : Rows) { Li = Blank(0, 14); }
+            for (std::uint64_t& Li : Cols) { Li = Blank(0, 14); }
+            for (int i = 0; i < 29; ++i)
+            {
+                Downs[i] = Blank(i < 14 ? 14 - i : 0, i < 14 ? 14 : 28 - i);
+                Ups[i] = Blank(i < 14 ? 0 : i - 14, i < 14 ? i : 14);
+            }
+        };
+        constexpr const Board& Plain() const &
+        {
+            return Bo;
+        };
+        constexpr std::uint64_t Hash() const &
+        {
+            return Bo.Hash();
+        };
+        constexpr int Rounds() const &
+        {
+            return Bo.Rounds();
+        };
+        constexpr Board::ChessCRef operator[](Position Po) const &
+        {
+            return Bo[Po];
+        };
+        constexpr ChessRef operator[](Position Po) &
+        {
+            return ChessRef{ this, Po };
+        };
+        constexpr Board::ChessCIte begin() const &
+        {
+            return Bo.begin();
+        };
+        constexpr Board::ChessCIte end() const &
+        {
+            return Bo.end();
+        };
+        constexpr std::uint32_t GetLine(Position Po, Orientation Or) const &
+        {
+            GOMOKU_COUNT(GetLine);
+            int PoX = Po.X();
+            int PoY = Po.Y();
+            std::uint64_t Li = 0u;
+            int Index = PoY;
+            if (Or == Orientation::Horizontal)
+            {
+                Li = Rows[PoY];
+                Index = PoX;
+            }
+            else if (Or == Orientation::Vertical) { Li = Cols[PoX]; }
+            else if (Or == Orientation::Downward) { Li = Downs[PoX - PoY + 14]; }
+            else { Li = Ups[PoX + PoY]; }
+            std::uint32_t Result = static_cast<std::uint32_t>(Li >> (Index * 2)) & 0x3FFFFu;
+            Result |= static_cast<std::uint32_t>(Or) << 30;
+            Result |= 0x3FFC0000u;
+            return Result;
+        };
+        constexpr LineBoard& operator ++()
+        {
+            ++Bo;
+            return *this;
+        };
+        constexpr LineBoard& operator ++(int) = delete;
+        constexpr LineBoard& operator --()
+        {
+            --Bo;
+            return *this;
+        };
+        constexpr LineBoard& operator --(int) = delete;
+        constexpr bool IsBlackTurn() const &
+        {
+            return Bo.IsBlackTurn();
+        };
+        constexpr bool IsPending() const &
+        {
+            return Bo.IsPending();
+        };
+        constexpr bool IsEnded() const &
+        {
+            return Bo.IsEnded();
+        };
+        constexpr bool CanPutChess(Position Po) const &
+        {
+            return Bo.CanPutChess(Po);
+        };
+    };
+    struct Counter
+    {
+    public:
+        enum struct Match : std::uint32_t
+        {
+            None = 0u,
+            T6 = 1u,
+            T5 = 2u,
+            D4 = 3u,
+            T4 = 4u,
+            T3 = 5u,
+        };
+        struct Pack
+        {
+        public:
+            std::uint32_t Mask;
+            std::uint32_t Case;
+            constexpr explicit Pack(std::uint32_t Mask, std::uint32_t Case)
+                : Mask{ Mask }, Case{ Case }
+            {};
+        };
+        struct Group
+        {
+        public:
+            int O0;
+            int O1;
+            int O2;
+            int O3;
+            constexpr explicit Group(int O0, int O1, int O2, int O3)
+                : O0{ O0 }, O1{ O1 }, O2{ O2 }, O3{ O3 }
+            {};
+        };
+        struct Forbids
+        {
+        public:
+            struct NibbleRef
+            {
+            private:
+                static constexpr const std::uint32_t Box = 0xFu;
+                std::uint32_t* Po;
+                int i;
+            public:
+                constexpr explicit NibbleRef(std::uint32_t* Po, int i)
+                    : Po{ Po }, i{ i }
+                {};
+                constexpr operator int() const
+                {
+                    int Shift = i * 4;
+                    return static_cast<int>((*Po >> Shift) & Box);
+                };
+                constexpr void operator =(int value) const
+                {
+                    int Shift = i * 4;
+                    *Po &= ~(Box << Shift);
+                    *Po |= (static_cast<std::uint32_t>(value) & Box) << Shift;
+                };
+                constexpr void operator +=(int value) const
+                {
+                    int Result = operator int() + value;
+                    operator =(Result < 0 || Result > 14 ? 15 : Result);
+                };
+                constexpr void operator -=(int value) const
+                {
+                    int Result = operator int() - value;
+                    operator =(Result < 0 || Result > 14 ? 15 : Result);
+                };
+            };
+        private:
+            std::uint32_t Po;
+        public:
+            constexpr Position P0() const &
+            {
+                return static_cast<Position>(Po & Byte);
+            };
+            constexpr void P0(Position value) &
+            {
+                Po &= ~Byte;
+                Po |= static_cast<std::uint32_t>(value);
+            };
+            constexpr Position P1() const &
+            {
+                return static_cast<Position>((Po >> 8) & Byte);
+            };
+            constexpr void P1(Position value) &
+            {
+                Po &= ~(Byte << 8);
+                Po |= static_cast<std::uint32_t>(value) << 8;
+            };
+            constexpr Position P2() const &
+            {
+                return static_cast<Position>((Po >> 16) & Byte);
+            };
+            constexpr void P2(Position value) &
+            {
+                Po &= ~(Byte << 16);
+                Po |= static_cast<std::uint32_t>(value) << 16;
+            };
+            constexpr Position P3() const &
+            {
+                return static_cast<Position>((Po >> 24) & Byte);
+            };
+            constexpr void P3(Position value) &
+            {
+                Po &= ~(Byte << 24);
+                Po |= static_cast<std::uint32_t>(value) << 24;
+            };
+            constexpr NibbleRef operator[](int i) &
+            {
+                return NibbleRef{ &Po, i };
+            };
+            constexpr int operator[](int i) const &
+            {
+                int Shift = i * 4;
+                return static_cast<int>((Po & (0xFu << Shift)) >> Shift);
+            };
+            constexpr Forbids(Position Po)
+                : Po{ static_cast<std::uint32_t>(Po) }
+            {
+                this->Po |= this->Po << 8;
+                this->Po |= this->Po << 16;
+            };
+        };
+        static const Group B3[12];
+        static const Pack D4[6];
+        static const Pack T3[12];
+        static const Pack T4[20];
+        static const Pack T5[5];
+        static const Pack T6[4];
+        static const std::array<std::uint8_t, 1u << 18> Table;
+        Position Po;
+        std::uint32_t C3;
+        std::uint32_t C4;
+        std::uint32_t C5;
+        std::uint32_t C6;
+        constexpr Counter(Position CurrentPo)
+            : Po{ CurrentPo }, C3{ 0u }, C4{ 0u }, C5{ 0u }, C6{ 0u }
+        {};
+        // Every box of the Black side is inverted when both of its bits agree, and every box of the White side
+        // is inverted, which is one XOR with a mask built from the whole word.
+        static constexpr std::uint32_t MySide(std::uint32_t Li, bool Bk)
+        {
+            std::uint32_t Agree = ~(Li ^ (Li >> 1)) & 0x15555u;
+            std::uint32_t Flip = Bk ? Agree * Box : 0x3FFFFu;
+            return ((Li ^ Flip) & 0x3FFFFu) | (Li & 0xC0000000u);
+        };
+        static constexpr std::uint32_t MySideByBoxes(std::uint32_t Li, bool Bk)
+        {
+            std::uint32_t Result = 0;
+            for (int Shift = 0; Shift < 18; Shift += 2)
+            {
+                std::uint32_t Temp = Li >> Shift;
+                if (!Bk || (Temp & Bit) == ((Temp >> 1) & Bit)) { Temp = ~Temp; }
+                Result |= (Temp & Box) << Shift;
+            }
+            Result |= Li & 0xC0000000u;
+            return Result;
+        };
+        template <std::size_t N>
+        static constexpr bool Exists(std::uint32_t MySide, const Pack(&Cases)[N])
+        {
+            for (Pack P : Cases)
+            {
+                if ((MySide & P.Mask) == P.Case)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+        static constexpr Match Classify(std::uint32_t MySide, bool Bk)
+        {
+            std::uint32_t Entry = Table[MySide & 0x3FFFFu];
+            if (Bk) { return static_cast<Match>(Entry & 0b111u); }
+            return (Entry & 0x80u) != 0u ? Match::T5 : Match::None;
+        };
+        static constexpr int Group3(std::uint32_t MySide)
+        {
+            return static_cast<int>((Table[MySide & 0x3FFFFu] >> 3) & Nibble);
+        };
+    private:
+        template <std::size_t N>
+        static constexpr void Tabulate(std::array<std::uint8_t, 1u << 18>& Result, const Pack(&Cases)[N], Match Ma)
+        {
+            for (int i = static_cast<int>(N) - 1; i >= 0; --i)
+            {
+                std::uint32_t Free = ~Cases[i].Mask & 0x3FFFFu;
+                std::uint32_t Sub = 0u;
+                do
+                {
+                    std::uint8_t& Entry = Result[Cases[i].Case | Sub];
+                    Entry &= ~0b111u;
+                    Entry |= static_cast<std::uint8_t>(Ma);
+                    if (Ma == Match::T3)
+                    {
+                        Entry &= ~(Nibble << 3);
+                        Entry |= static_cast<std::uint8_t>(i << 3);
+                    }
+                    else if (Ma == Match::T5) { Entry |= 0x80u; }
+                    Sub = (Sub - Free) & Free;
+                } while (Sub != 0u);
+            }
+        };
+    public:
+        static constexpr std::array<std::uint8_t, 1u << 18> Tabulate()
+        {
+            std::array<std::uint8_t, 1u << 18> Result{};
+            Tabulate(Result, T3, Match::T3);
+            Tabulate(Result, T4, Match::T4);
+            Tabulate(Result, D4, Match::D4);
+            Tabulate(Result, T5, Match::T5);
+            Tabulate(Result, T6, Match::T6);
+            return Result;
+        };
+    };
+    struct Memo
+    {
+    public:
+        static constexpr const std::uint32_t Size = 1024u;
+    private:
+        struct Slot
+        {
+        public:
+            std::uint64_t Key;
+            std::uint8_t Po;
+            bool Forbid;
+            constexpr Slot()
+                : Key{ 0u }, Po{ Byte }, Forbid{ false }
+            {};
+        };
+        std::array<Slot, Size> Slots;
+    public:
+        std::uint64_t Hits;
+        std::uint64_t Misses;
+        std::uint32_t Depth;
+        std::uint32_t Deepest;
+        constexpr Memo()
+            : Slots{}, Hits{ 0u }, Misses{ 0u }, Depth{ 0u }, Deepest{ 0u }
+        {};
+        constexpr double HitRate() const &
+        {
+            return Hits + Misses > 0u ? static_cast<double>(Hits) / static_cast<double>(Hits + Misses) : 0e0;
+        };
+        constexpr bool Find(std::uint64_t Key, Position Po, bool& Forbid) &
+        {
+            const Slot& Sl = Slots[Index(Key, Po)];
+            if (Sl.Key != Key || Sl.Po != static_cast<std::uint8_t>(Po))
+            {
+                ++Misses;
+                return false;
+            }
+            ++Hits;
+            Forbid = Sl.Forbid;
+            return true;
+        };
+        constexpr void Keep(std::uint64_t Key, Position Po, bool Forbid) &
+        {
+            Slot& Sl = Slots[Index(Key, Po)];
+            Sl.Key = Key;
+            Sl.Po = static_cast<std::uint8_t>(Po);
+            Sl.Forbid = Forbid;
+        };
+    private:
+        static constexpr std::uint32_t Index(std::uint64_t Key, Position Po)
+        {
+            return (static_cast<std::uint32_t>(Key >> 32) ^ static_cast<std::uint32_t>(Po) * 0x9E3779B1u) & (Size - 1u);
+        };
+    };
+    // The points where a BasicReferee given a Footprint has called the S3Forbid, one bit each by rows. A call
+    // reads the Board only on the 4 lines through its point within 4 boxes, so a Chess put anywhere else than on
+    // those lines of any of the points cannot change what the calls found. A Memo answers a call without the
+    // calls below it, so a Footprint is only whole without one.
+    struct Footprint
+    {
+    public:
+        std::uint32_t Rows[15];
+        constexpr void Clear() &
+        {
+            for (std::uint32_t& Li : Rows) { Li = 0u; }
+        };
+        // Leaves out a Position clamped off the Board by the Counter.Forbids, which reads as a blocked box.
+        constexpr void Add(Position Po) &
+        {
+            int PoX = Po.X();
+            int PoY = Po.Y();
+            if (PoX == 15 || PoY == 15) { return; }
+            Rows[PoY] |= Bit << PoX;
+        };
+        constexpr bool Meets(const std::uint32_t (&Other)[15]) const &
+        {
+            std::uint32_t Common = 0u;
+            for (int Y = 0; Y < 15; ++Y) { Common |= Rows[Y] & Other[Y]; }
+            return Common != 0u;
+        };
+    };
+#pragma endregion
+#pragma region referees
+    struct Verdict
+    {
+    public:
+        Result Re;
+        Forbidden Fo;
+        constexpr explicit Verdict(Result Re, Forbidden Fo)
+            : Re{ Re }, Fo{ Fo }
+        {};
+    };
+    template <typename B>
+    class BasicReferee
+    {
+    private:
+        B& Bo;
+        Memo* Me;
+        Footprint* Fp;
+    public:
+        constexpr explicit BasicReferee(B& Bo, Memo* Me = nullptr, Footprint* Fp = nullptr)
+            : Bo{ Bo }, Me{ Me }, Fp{ Fp }
+        {};
+        constexpr Counter::Forbids FindForbidPos(std::uint32_t MySide, Position Po) const &
+        {
+            GOMOKU_COUNT(FindForbidPos);
+            Orientation Or = static_cast<Orientation>(MySide >> 30);
+            Counter::Forbids Fo = Counter::Forbids{ Po };
+            int i = Counter::Group3(MySide);
+            if (Or == Orientation::Horizontal)
+            {
+                Fo[0] += Counter::B3[i].O0;
+                Fo[2] += Counter::B3[i].O1;
+                Fo[4] += Counter::B3[i].O2;
+                Fo[6] += Counter::B3[i].O3;
+            }
+            else if (Or == Orientation::Vertical)
+            {
+                Fo[1] += Counter::B3[i].O0;
+                Fo[3] += Counter::B3[i].O1;
+                Fo[5] += Counter::B3[i].O2;
+                Fo[7] += Counter::B3[i].O3;
+            }
+            else if (Or == Orientation::Downward)
+            {
+                Fo[0] += Counter::B3[i].O0;
+                Fo[2] += Counter::B3[i].O1;
+                Fo[4] += Counter::B3[i].O2;
+                Fo[6] += Counter::B3[i].O3;
+                Fo[1] += Counter::B3[i].O0;
+                Fo[3] += Counter::B3[i].O1;
+                Fo[5] += Counter::B3[i].O2;
+                Fo[7] += Counter::B3[i].O3;
+            }
+            else if (Or == Orientation::Upward)
+            {
+                Fo[0] -= Counter::B3[i].O0;
+                Fo[2] -= Counter::B3[i].O1;
+                Fo[4] -= Counter::B3[i].O2;
+                Fo[6] -= Counter::B3[i].O3;
+                Fo[1] += Counter::B3[i].O0;
+                Fo[3] += Counter::B3[i].O1;
+                Fo[5] += Counter::B3[i].O2;
+                Fo[7] += Counter::B3[i].O3;
+            }
+            return Fo;
+        };
+        constexpr void CountMatches(std::uint32_t Li, Counter& Co) &
+        {
+            CountMatches(Li, Co, Bo.IsBlackTurn());
+        };
+        constexpr void CountMatches(std::uint32_t Li, Counter& Co, bool Bk) &
+        {
+            GOMOKU_COUNT(CountMatches);
+            std::uint32_t MySide = Counter::MySide(Li, Bk);
+            Counter::Match Ma = Counter::Classify(MySide, Bk);
+            if (Ma == Counter::Match::T6) { ++Co.C6; }
+            else if (Ma == Counter::Match::T5) { ++Co.C5; }
+            else if (Ma == Counter::Match::D4) { Co.C4 += 2; }
+            else if (Ma == Counter::Match::T4) { ++Co.C4; }
+            else if (Ma == Counter::Match::T3)
+            {
+                Counter::Forbids Fo = FindForbidPos(MySide, Co.Po);
+                Position P0 = Fo.P0();
+                if (P0 == Co.Po)
+                {
+                    if (!(S3Forbid(Fo.P1()) || S3Forbid(Fo.P2()) || S3Forbid(Fo.P3()))) { ++Co.C3; }
+                }
+                else if (!(S3Forbid(P0) || S3Forbid(Fo.P1())) || !(S3Forbid(Fo.P2()) || S3Forbid(Fo.P3()))) { ++Co.C3; }
+            }
+        };
+        constexpr bool S3Forbid(Position Po) &
+        {
+            GOMOKU_DESCENT();
+            Counter Co = Counter{ Po };
+            if (Bo[Po] != Chess::None) { return true; }
+            if (Fp != nullptr) { Fp->Add(Po); }
+            std::uint64_t Key = Bo.Hash();
+            bool Forbid = false;
+            if (Me != nullptr)
+            {
+                if (Me->Find(Key, Po, Forbid)) { return Forbid; }
+                if (++Me->Depth > Me->Deepest) { Me->Deepest = Me->Depth; }
+            }
+            Bo[Po] = Chess::Black;
+            Tally(Co, true);
+            Bo[Po] = Chess::None;
+            Forbid = Co.C3 >= 2u || Co.C4 >= 2u || Co.C5 > 0u || Co.C6 > 0u;
+            if (Me != nullptr)
+            {
+                --Me->Depth;
+                Me->Keep(Key, Po, Forbid);
+            }
+            return Forbid;
+        };
+        constexpr Forbidden Forbid(Position Po) &
+        {
+            Counter Co = Counter{ Po };
+            if (Bo[Po] != Chess::None) { return Forbidden::None; }
+            Bo[Po] = Chess::Black;
+            Tally(Co, true);
+            Bo[Po] = Chess::None;
+            return Judge(Co, true).Fo;
+        };
+        constexpr Verdict MakeResult(Position Po) &
+        {
+            GOMOKU_SPAN(Po, Bo.Hash(), Bo.Rounds());
+            bool Bk = Bo.IsBlackTurn();
+            Counter Co = Counter{ Po };
+            Tally(Co, Bk);
+            return Judge(Co, Bk);
+        };
+    private:
+        constexpr void Tally(Counter& Co, bool Bk) &
+        {
+            CountMatches(Bo.GetLine(Co.Po, Orientation::Horizontal), Co, Bk);
+            CountMatches(Bo.GetLine(Co.Po, Orientation::Vertical), Co, Bk);
+            CountMatches(Bo.GetLine(Co.Po, Orientation::Downward), Co, Bk);
+            CountMatches(Bo.GetLine(Co.Po, Orientation::Upward), Co, Bk);
+        };
+        static constexpr Verdict Judge(const Counter& Co, bool Bk)
+        {
+            if (Bk)
+            {
+                if (Co.C6 > 0u) { return Verdict{ Result::Lost, Forbidden::Overline }; }
+                else if (Co.C4 >= 2u) { return Verdict{ Result::Lost, Forbidden::FourFour }; }
+                else if (Co.C3 >= 2u) { return Verdict{ Result::Lost, Forbidden::ThreeThree }; }
+                else if (Co.C5 > 0u) { return Verdict{ Result::Won, Forbidden::None }; }
+            }
+            else if (Co.C5 > 0u) { return Verdict{ Result::Lost, Forbidden::None }; }
+            return Verdict{ Result::None, Forbidden::None };
+        };
+    public:
+        constexpr Verdict PutChess(Position Po) &
+        {
+            if (Bo.IsBlackTurn()) { Bo[Po] = Chess::Black; }
+            else { Bo[Po] = Chess::White; }
+            Verdict Ve = MakeResult(Po);
+            ++Bo;
+            if (Ve.Re == Result::None && Bo.IsEnded()) { Ve.Re = Result::Tied; }
+            return Ve;
+        };
+    };
+    using Referee = BasicReferee<Board>;
+    using LineReferee = BasicReferee<LineBoard>;
+#pragma endregion
+#pragma region global-initializes
+    inline constexpr const Position Position::Null{ 15, 15 };
+    inline constexpr const std::array<std::uint64_t, 512> Zobrist::Keys = Zobrist::Tabulate();
+    inline constexpr const Counter::Group Counter::B3[12]{
+        Group{ -3, -4, 1, 2 },
+        Group{ -3, -4, 1, 2 },
+        Group{ -2, -3, 2, 3 },
+        Group{ -2, -3, 2, 3 },
+        Group{ -1, -2, 3, 4 },
+        Group{ -1, -2, 3, 4 },
+        Group{ 0, -2, -4, 1 },
+        Group{ 0, 1, -2, 3 },
+        Group{ 0, -1, -3, 2 },
+        Group{ 0, 2, -1, 4 },
+        Group{ 0, -1, -4, 1 },
+        Group{ 0, 1, -1, 4 },
+    };
+    inline constexpr const Counter::Pack Counter::D4[6]{
+        Pack{ 0b111111111111111111u, 0b010101110111010101u },
+        Pack{ 0b001111111111111111u, 0b000101110101110101u },
+        Pack{ 0b111111111111111100u, 0b010111010111010100u },
+        Pack{ 0b000011111111111111u, 0b000001110101011101u },
+        Pack{ 0b001111111111111100u, 0b000111010101110100u },
+        Pack{ 0b111111111111110000u, 0b011101010111010000u },
+    };
+    inline constexpr const Counter::Pack Counter::T3[12]{
+        Pack{ 0b000000111111111111u, 0b000000110101011111u },
+        Pack{ 0b000011111111111100u, 0b000011110101011100u },
+        Pack{ 0b000011111111111100u, 0b000011010101111100u },
+        Pack{ 0b001111111111110000u, 0b001111010101110000u },
+        Pack{ 0b001111111111110000u, 0b001101010111110000u },
+        Pack{ 0b111111111111000000u, 0b111101010111000000u },
+        Pack{ 0b000000111111111111u, 0b000000110101110111u },
+        Pack{ 0b001111111111110000u, 0b001101110101110000u },
+        Pack{ 0b000011111111111100u, 0b000011010111011100u },
+        Pack{ 0b111111111111000000u, 0b110111010111000000u },
+        Pack{ 0b000000111111111111u, 0b000000110111010111u },
+        Pack{ 0b111111111111000000u, 0b110101110111000000u },
+    };
+    inline constexpr const Counter::Pack Counter::T4[20]{
+        Pack{ 0b000000001111111111u, 0b000000000101010111u },
+        Pack{ 0b000000111111111100u, 0b000000110101010100u },
+        Pack{ 0b000000111111111100u, 0b000000010101011100u },
+        Pack{ 0b000011111111110000u, 0b000011010101010000u },
+        Pack{ 0b000011111111110000u, 0b000001010101110000u },
+        Pack{ 0b001111111111000000u, 0b001101010101000000u },
+        Pack{ 0b001111111111000000u, 0b000101010111000000u },
+        Pack{ 0b111111111100000000u, 0b110101010100000000u },
+        Pack{ 0b000000001111111111u, 0b000000000101011101u },
+        Pack{ 0b000011111111110000u, 0b000001110101010000u },
+        Pack{ 0b000000111111111100u, 0b000000010101110100u },
+        Pack{ 0b001111111111000000u, 0b000111010101000000u },
+        Pack{ 0b000011111111110000u, 0b000001010111010000u },
+        Pack{ 0b111111111100000000u, 0b011101010100000000u },
+        Pack{ 0b000000001111111111u, 0b000000000101110101u },
+        Pack{ 0b001111111111000000u, 0b000101110101000000u },
+        Pack{ 0b000000111111111100u, 0b000000010111010100u },
+        Pack{ 0b111111111100000000u, 0b010111010100000000u },
+        Pack{ 0b000000001111111111u, 0b000000000111010101u },
+        Pack{ 0b111111111100000000u, 0b010101110100000000u },
+    };
+    inline constexpr const Counter::Pack Counter::T5[5]{
+        Pack{ 0b000000001111111111u, 0b000000000101010101u },
+        Pack{ 0b000000111111111100u, 0b000000010101010100u },
+        Pack{ 0b000011111111110000u, 0b000001010101010000u },
+        Pack{ 0b001111111111000000u, 0b000101010101000000u },
+        Pack{ 0b111111111100000000u, 0b010101010100000000u },
+    };
+    inline constexpr const Counter::Pack Counter::T6[4]{
+        Pack{ 0b000000111111111111u, 0b000000010101010101u },
+        Pack{ 0b000011111111111100u, 0b000001010101010100u },
+        Pack{ 0b001111111111110000u, 0b000101010101010000u },
+        Pack{ 0b111111111111000000u, 0b010101010101000000u },
+    };
+    inline constexpr const std::array<std::uint8_t, 1u << 18> Counter::Table = Counter::Tabulate();
+#pragma endregion
+}
@@ -0,0 +1,329 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <memory>
+#include <utility>
+#include "Raster.h"
+#include "Referee.h"
+namespace Gomoku
+{
+    // The geometry and the colours of the Board drawn in the window, which every RasterTarget shares.
+    class Layout
+    {
+#pragma region constants
+    private:
+        static constexpr const int DefBp = 80;
+        static constexpr const int DefLw = 3;
+        static constexpr const int DefGs = 40;
+        static constexpr const float DefCSiz = 0.75F;
+        static constexpr const float DefCTou = 0.9F;
+        static constexpr const float DefCSha = 1.125F;
+        static constexpr const float DefCMar = 0.375F;
+    public:
+        static constexpr const Color BoardColor = 0xFFF5DEB3u;
+        static constexpr const Color LineColor = 0xFFDEB887u;
+        static constexpr const Color ShadowColor = 0x10000000u;
+        static constexpr const Color BlackChessLightColor = 0xFFA0A0A0u;
+        static constexpr const Color BlackChessDarkColor = 0xFF000000u;
+        static constexpr const Color WhiteChessLightColor = 0xFFFFFFFFu;
+        static constexpr const Color WhiteChessDarkColor = 0xFFF0F0F0u;
+#pragma endregion
+#pragma region fields
+    private:
+        int Bp;
+        int Lw;
+        int Gs;
+        float CSiz;
+        float CTou;
+        float CSha;
+        float CMar;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        constexpr int BoardPadding() const &
+        {
+            return Bp;
+        };
+        constexpr int LineWeight() const &
+        {
+            return Lw;
+        };
+        constexpr int GridSize() const &
+        {
+            return Gs;
+        };
+        constexpr float ChessSizeScale() const &
+        {
+            return CSiz;
+        };
+        constexpr float ChessTouchScale() const &
+        {
+            return CTou;
+        };
+        constexpr float ChessShadowScale() const &
+        {
+            return CSha;
+        };
+        constexpr float ChessMarginScale() const &
+        {
+            return CMar;
+        };
+        constexpr Layout()
+            : Bp{ DefBp }, Lw{ DefLw }, Gs{ DefGs }, CSiz{ DefCSiz }, CTou{ DefCTou }, CSha{ DefCSha }, CMar{ DefCMar }
+        {};
+        constexpr bool SetParams(int BoardPadding, int LineWeight, int GridSize) &
+        {
+            if (LineWeight >= GridSize) { return false; }
+            else if (GridSize >= BoardPadding) { return false; }
+            else if (BoardPadding <= 0) { return false; }
+            Bp = BoardPadding;
+            Lw = LineWeight;
+            Gs = GridSize;
+            return true;
+        };
+        constexpr bool SetScales(float ChessSizeScale, float ChessTouchScale, float ChessShadowScale, float ChessMarginScale) &
+        {
+            if (ChessSizeScale <= 0 || ChessSizeScale > 1) { return false; }
+            else if (ChessTouchScale <= 0 || ChessTouchScale > 1) { return false; }
+            else if (ChessShadowScale <= 0 || ChessShadowScale > 1) { return false; }
+            else if (ChessMarginScale <= 0 || ChessMarginScale > 1) { return false; }
+            CSiz = ChessSizeScale;
+            CTou = ChessTouchScale;
+            CSha = ChessShadowScale;
+            CMar = ChessMarginScale;
+            return true;
+        };
+        constexpr int BoardOuterSize() const &
+        {
+            return Bp * 2 + Lw * 15 + Gs * 14;
+        };
+        constexpr int BoardInnerSize() const &
+        {
+            return Lw * 15 + Gs * 14;
+        };
+        constexpr int GsScaleToLw(float C) const &
+        {
+            int Result = static_cast<int>(Gs * C);
+            return Lw % 2 == Result % 2 ? Result : Result + 1;
+        };
+        constexpr int ChessSize() const &
+        {
+            return GsScaleToLw(CSiz);
+        };
+        constexpr int ChessTouch() const &
+        {
+            return GsScaleToLw(CTou);
+        };
+        constexpr int ChessShadow() const &
+        {
+            return GsScaleToLw(CSha);
+        };
+        constexpr int ChessMargin() const &
+        {
+            return GsScaleToLw(CMar);
+        };
+        constexpr Point GetPoint(Position Po) const &
+        {
+            int Begin = Bp + Lw / 2;
+            int Step = Gs + Lw;
+            return Point{ Begin + Step * Po.X(), Begin + Step * Po.Y() };
+        };
+        constexpr Rect GetChessRect(const Point& Pt) const &
+        {
+            int Size = ChessSize();
+            if (Size % 2 != Lw % 2) { ++Size; }
+            return Rect{ Pt.X - Size / 2 - 1, Pt.Y - Size / 2 - 1, Size + 1, Size + 1 };
+        };
+        friend constexpr bool operator ==(const Layout& Left, const Layout& Right) = default;
+#pragma endregion
+    };
+    // Keeps the empty Board and a sprite for each of the Black and White Chesses and the shadow, rendered once
+    // for each Layout, and composites them into a back buffer, remembering the dirty Rect that has changed
+    // since the last TakeDirty, so that only that Rect needs presenting.
+    class BoardRenderer
+    {
+#pragma region fields
+    private:
+        Layout La;
+        std::unique_ptr<RasterTarget> Back;
+        std::unique_ptr<RasterTarget> Empty;
+        std::unique_ptr<RasterTarget> BlackSprite;
+        std::unique_ptr<RasterTarget> WhiteSprite;
+        std::unique_ptr<RasterTarget> ShadowSprite;
+        Rect Dirty;
+        bool Cached;
+        bool Stale;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        BoardRenderer()
+            : La{}, Back{}, Empty{}, BlackSprite{}, WhiteSprite{}, ShadowSprite{}, Dirty{ 0, 0, 0, 0 }, Cached{ false }, Stale{ false }
+        {};
+        explicit BoardRenderer(std::unique_ptr<RasterTarget> Target)
+            : La{}, Back{ std::move(Target) }, Empty{}, BlackSprite{}, WhiteSprite{}, ShadowSprite{}, Dirty{ 0, 0, 0, 0 }, Cached{ false }, Stale{ false }
+        {};
+        // Takes the target whose Offscreen makes the back buffer and the caches, dropping those of the last one.
+        void Attach(std::unique_ptr<RasterTarget> Target) &
+        {
+            Release();
+            Back = std::move(Target);
+        };
+        void Release() &
+        {
+            ShadowSprite.reset();
+            WhiteSprite.reset();
+            BlackSprite.reset();
+            Empty.reset();
+            Back.reset();
+            Dirty = Rect{ 0, 0, 0, 0 };
+            Cached = false;
+            Stale = false;
+        };
+        bool Attached() const &
+        {
+            return Back != nullptr;
+        };
+        const RasterTarget& Buffer() const &
+        {
+            return *Back;
+        };
+        // Whether the back buffer has been made again by the Prepare and is yet to be given a RenderClient.
+        bool IsStale() const &
+        {
+            return Stale;
+        };
+        // Renders the caches again when Next differs from the Layout they were rendered for, and then the back
+        // buffer is empty and stale until it is given a RenderClient.
+        bool Prepare(const Layout& Next) &
+        {
+            if (Cached && La == Next) { return false; }
+            La = Next;
+            int Outer = La.BoardOuterSize();
+            Back = Back->Offscreen(Outer, Outer);
+            Empty = Back->Offscreen(Outer, Outer);
+            PaintBoard(*Empty);
+            Rect Sprite = La.GetChessRect(Point{ 0, 0 });
+            Point Origin{ -Sprite.X, -Sprite.Y };
+            Sprite = La.GetChessRect(Origin);
+            BlackSprite = Back->Offscreen(Sprite.Width, Sprite.Height);
+            PaintSprite(*BlackSprite, Sprite, true);
+            WhiteSprite = Back->Offscreen(Sprite.Width, Sprite.Height);
+            PaintSprite(*WhiteSprite, Sprite, false);
+            ShadowSprite = Back->Offscreen(Sprite.Width, Sprite.Height);
+            ShadowSprite->FillEllipse(Sprite, Layout::ShadowColor);
+            Cached = true;
+            Stale = true;
+            Invalidate();
+            return true;
+        };
+        void RenderClient(const Board& Bo) &
+        {
+            Back->Draw(*Empty, Rect{ 0, 0, Empty->Width(), Empty->Height() }, 0, 0);
+            for (Board::ChessCRef Ch : Bo)
+            {
+                if (Ch == Chess::Black) { Blit(*BlackSprite, Ch.Pos()); }
+                else if (Ch == Chess::White) { Blit(*WhiteSprite, Ch.Pos()); }
+            }
+            Stale = false;
+            Invalidate();
+        };
+        void PaintChess(Position Po, bool Bk) &
+        {
+            Restore(Po);
+            Blit(Bk ? *BlackSprite : *WhiteSprite, Po);
+        };
+        void PaintShadow(Position Po) &
+        {
+            Blit(*ShadowSprite, Po);
+        };
+        void ClearGrid(Position Po) &
+        {
+            Restore(Po);
+        };
+        void Invalidate() &
+        {
+            Dirty = Rect{ 0, 0, Back->Width(), Back->Height() };
+        };
+        Rect TakeDirty() &
+        {
+            Rect Re = Dirty;
+            Dirty = Rect{ 0, 0, 0, 0 };
+            return Re;
+        };
+    private:
+        void Restore(Position Po) &
+        {
+            Rect CRect = La.GetChessRect(La.GetPoint(Po));
+            Back->Draw(*Empty, CRect, CRect.X, CRect.Y);
+            Dirty = Dirty.Union(CRect);
+        };
+        void Blit(const RasterTarget& Sprite, Position Po) &
+        {
+            Rect CRect = La.GetChessRect(La.GetPoint(Po));
+            Back->Draw(Sprite, Rect{ 0, 0, Sprite.Width(), Sprite.Height() }, CRect.X, CRect.Y);
+            Dirty = Dirty.Union(CRect);
+        };
+        void PaintBoard(RasterTarget& Ta) const &
+        {
+            Ta.Clear(Layout::BoardColor);
+            int Inner = La.BoardInnerSize();
+            int Bp = La.BoardPadding();
+            int Lw = La.LineWeight();
+            int Gs = La.GridSize();
+            int Begin = Bp + Lw / 2;
+            int End = Bp + Inner - Lw / 2;
+            int Size = Inner - Lw;
+            int Step = Gs + Lw;
+            int Half = Lw / 2;
+            Ta.FillRect(Rect{ Begin - Half, Begin - Half, Size + Lw, Lw }, Layout::LineColor);
+            Ta.FillRect(Rect{ Begin - Half, Begin + Size - Half, Size + Lw, Lw }, Layout::LineColor);
+            Ta.FillRect(Rect{ Begin - Half, Begin - Half, Lw, Size + Lw }, Layout::LineColor);
+            Ta.FillRect(Rect{ Begin + Size - Half, Begin - Half, Lw, Size + Lw }, Layout::LineColor);
+            for (int i = 0; i < 15; ++i)
+            {
+                int Adjusted = Begin + Step * i;
+                Ta.FillRect(Rect{ Begin, Adjusted - Half, End - Begin, Lw }, Layout::LineColor);
+                Ta.FillRect(Rect{ Adjusted - Half, Begin, Lw, End - Begin }, Layout::LineColor);
+            }
+        };
+        // Paints a Chess in CRect as the dark colour with a gradient from the light colour about the centre of
+        // the shadow ellipse, which is offset to the upper left by the ChessMargin.
+        void PaintSprite(RasterTarget& Ta, const Rect& CRect, bool Bk) const &
+        {
+            int CMar = La.ChessMargin();
+            int CSha = La.ChessShadow();
+            Rect SRect{ CRect.X - CMar, CRect.Y - CMar, CSha, CSha };
+            Color Dark = Bk ? Layout::BlackChessDarkColor : Layout::WhiteChessDarkColor;
+            Color Light = Bk ? Layout::BlackChessLightColor : Layout::WhiteChessLightColor;
+            Ta.FillEllipse(CRect, Dark);
+            Ta.FillGradient(CRect, SRect, Light, Dark);
+        };
+#pragma endregion
+    };
+}
@@ -0,0 +1,182 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace Gomoku
+{
+    class Scheduler
+    {
+#pragma region helper-classes
+    private:
+        struct Range
+        {
+        public:
+            std::size_t Begin;
+            std::size_t End;
+        };
+        struct Queue
+        {
+        public:
+            std::mutex Lock;
+            std::deque<Range> Ranges;
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        std::vector<std::unique_ptr<Queue>> Queues;
+        std::vector<std::thread> Workers;
+        std::function<void(std::size_t, unsigned)> Job;
+        std::mutex Lock;
+        std::condition_variable Wake;
+        std::condition_variable Done;
+        std::atomic<std::size_t> Pending;
+        std::size_t Generation;
+        unsigned Busy;
+        bool Stopping;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit Scheduler(unsigned Threads)
+            : Queues{}, Workers{}, Job{}, Lock{}, Wake{}, Done{}, Pending{ 0u }, Generation{ 0u }, Busy{ 0u }, Stopping{ false }
+        {
+            if (Threads == 0u) { Threads = std::max(std::thread::hardware_concurrency(), 1u); }
+            for (unsigned i = 0; i < Threads; ++i) { Queues.emplace_back(std::make_unique<Queue>()); }
+            for (unsigned i = 1; i < Threads; ++i) { Workers.emplace_back(&Scheduler::Work, this, i); }
+        };
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator =(const Scheduler&) = delete;
+        ~Scheduler()
+        {
+            {
+                std::lock_guard<std::mutex> Guard{ Lock };
+                Stopping = true;
+            }
+            Wake.notify_all();
+            for (std::thread& Th : Workers) { Th.join(); }
+        };
+        unsigned Threads() const &
+        {
+            return static_cast<unsigned>(Queues.size());
+        };
+        template <typename F>
+        void ParallelFor(std::size_t Count, std::size_t Grain, F&& Fn) &
+        {
+            if (Count == 0u) { return; }
+            if (Grain == 0u) { Grain = 1u; }
+            std::size_t Chunks = (Count + Grain - 1u) / Grain;
+            for (std::size_t i = 0; i < Chunks; ++i)
+            {
+                Queue& Qu = *Queues[i % Queues.size()];
+                std::size_t Begin = i * Grain;
+                std::lock_guard<std::mutex> Guard{ Qu.Lock };
+                Qu.Ranges.push_back(Range{ Begin, std::min(Begin + Grain, Count) });
+            }
+            {
+                std::lock_guard<std::mutex> Guard{ Lock };
+                Job = [&Fn](std::size_t Index, unsigned Worker) { Fn(Index, Worker); };
+                Pending.store(Chunks, std::memory_order_relaxed);
+                Busy = static_cast<unsigned>(Workers.size());
+                ++Generation;
+            }
+            Wake.notify_all();
+            Drain(0u);
+            std::unique_lock<std::mutex> Guard{ Lock };
+            Done.wait(Guard, [this]() { return Pending.load(std::memory_order_acquire) == 0u && Busy == 0u; });
+            Job = nullptr;
+        };
+    private:
+        bool Take(unsigned Worker, Range& Ra) &
+        {
+            {
+                Queue& Own = *Queues[Worker];
+                std::lock_guard<std::mutex> Guard{ Own.Lock };
+                if (!Own.Ranges.empty())
+                {
+                    Ra = Own.Ranges.back();
+                    Own.Ranges.pop_back();
+                    return true;
+                }
+            }
+            for (std::size_t i = 1; i < Queues.size(); ++i)
+            {
+                Queue& Victim = *Queues[(Worker + i) % Queues.size()];
+                std::lock_guard<std::mutex> Guard{ Victim.Lock };
+                if (!Victim.Ranges.empty())
+                {
+                    Ra = Victim.Ranges.front();
+                    Victim.Ranges.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        };
+        void Drain(unsigned Worker) &
+        {
+            Range Ra{ 0u, 0u };
+            while (Take(Worker, Ra))
+            {
+                for (std::size_t i = Ra.Begin; i < Ra.End; ++i) { Job(i, Worker); }
+                if (Pending.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+                {
+                    std::lock_guard<std::mutex> Guard{ Lock };
+                    Done.notify_all();
+                }
+            }
+        };
+        void Work(unsigned Worker) &
+        {
+            std::size_t Seen = 0u;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> Guard{ Lock };
+                    Wake.wait(Guard, [this, Seen]() { return Stopping || Generation != Seen; });
+                    if (Stopping) { return; }
+                    Seen = Generation;
+                }
+                Drain(Worker);
+                {
+                    std::lock_guard<std::mutex> Guard{ Lock };
+                    --Busy;
+                }
+                Done.notify_all();
+            }
+        };
+#pragma endregion
+    };
+}
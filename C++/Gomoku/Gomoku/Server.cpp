@@ -0,0 +1,319 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "GameServer.h"
+namespace Gomoku
+{
+    // Serves the GameServer over TCP or a Unix socket, where one thread accepts the connections and hands them
+    // in turn to a pool of event loops, each waiting on an epoll of its own for its connections to read from or
+    // to write to, and running the complete lines read in order.
+    class Server
+    {
+#pragma region constants
+    private:
+        static constexpr const int Events = 256;
+        static constexpr const std::size_t Chunk = 1u << 16;
+        // A connection is dropped when it has more than Longest bytes without a line break, or more than
+        // Backlog bytes of answers it has not taken.
+        static constexpr const std::size_t Longest = 1u << 12;
+        static constexpr const std::size_t Backlog = 1u << 20;
+#pragma endregion
+#pragma region helper-classes
+    private:
+        struct Connection
+        {
+        public:
+            int Fd;
+            std::string In;
+            std::string Out;
+            std::size_t Sent;
+            std::size_t Slot;
+            std::uint32_t Watched;
+            bool Ending;
+        };
+        struct Loop
+        {
+        public:
+            int Epoll;
+            std::thread Worker;
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        static inline std::atomic<bool> Stopping{ false };
+        GameServer Host;
+        std::vector<Loop> Loops;
+        std::mutex Lock;
+        std::vector<Connection*> Open;
+        std::atomic<std::uint64_t> Accepted;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            int Port = 5515;
+            const char* Path = nullptr;
+            unsigned Threads = 0u;
+            for (int i = 1; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) { Port = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) { Path = argv[++i]; }
+                else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { Threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+                else
+                {
+                    std::fprintf(stderr, "usage: %s [--port N | --socket path] [--threads N]\n", argv[0]);
+                    return 1;
+                }
+            }
+            if (Threads == 0u) { Threads = std::max(std::thread::hardware_concurrency(), 1u); }
+            int Listener = Listen(Port, Path);
+            if (Listener < 0)
+            {
+                std::fprintf(stderr, "cannot listen on %s\n", Path != nullptr ? Path : std::to_string(Port).c_str());
+                return 1;
+            }
+            std::signal(SIGINT, Stop);
+            std::signal(SIGTERM, Stop);
+            std::signal(SIGPIPE, SIG_IGN);
+            std::unique_ptr<Server> Sv = std::make_unique<Server>();
+            std::fprintf(stderr, "listening on %s, %u event loops\n", Path != nullptr ? Path : std::to_string(Port).c_str(), Threads);
+            Sv->Run(Listener, Threads);
+            close(Listener);
+            if (Path != nullptr) { unlink(Path); }
+            std::fprintf(stderr, "connections %llu, commands %llu, games open %lld\n", static_cast<unsigned long long>(Sv->Accepted.load()),
+                static_cast<unsigned long long>(Sv->Host.Executed()), static_cast<long long>(Sv->Host.Games()));
+            return 0;
+        };
+        Server()
+            : Host{}, Loops{}, Lock{}, Open{}, Accepted{ 0u }
+        {};
+    private:
+        static void Stop(int)
+        {
+            Stopping.store(true);
+        };
+        static int Listen(int Port, const char* Path)
+        {
+            int Fd = -1;
+            if (Path != nullptr)
+            {
+                sockaddr_un Address{};
+                if (std::strlen(Path) >= sizeof(Address.sun_path)) { return -1; }
+                Address.sun_family = AF_UNIX;
+                std::strcpy(Address.sun_path, Path);
+                unlink(Path);
+                Fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+                if (Fd >= 0 && bind(Fd, reinterpret_cast<sockaddr*>(&Address), sizeof(Address)) != 0) { Fd = Close(Fd); }
+            }
+            else
+            {
+                sockaddr_in Address{};
+                Address.sin_family = AF_INET;
+                Address.sin_port = htons(static_cast<std::uint16_t>(Port));
+                Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+                Fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+                int On = 1;
+                if (Fd >= 0) { setsockopt(Fd, SOL_SOCKET, SO_REUSEADDR, &On, sizeof(On)); }
+                if (Fd >= 0 && bind(Fd, reinterpret_cast<sockaddr*>(&Address), sizeof(Address)) != 0) { Fd = Close(Fd); }
+            }
+            if (Fd >= 0 && listen(Fd, SOMAXCONN) != 0) { Fd = Close(Fd); }
+            return Fd;
+        };
+        static int Close(int Fd)
+        {
+            close(Fd);
+            return -1;
+        };
+        void Run(int Listener, unsigned Threads) &
+        {
+            for (unsigned i = 0; i < Threads; ++i) { Loops.push_back(Loop{ epoll_create1(0), std::thread{} }); }
+            for (Loop& Lo : Loops) { Lo.Worker = std::thread{ &Server::Serve, this, Lo.Epoll }; }
+            int Epoll = epoll_create1(0);
+            epoll_event Ev{};
+            Ev.events = EPOLLIN;
+            Ev.data.fd = Listener;
+            epoll_ctl(Epoll, EPOLL_CTL_ADD, Listener, &Ev);
+            std::size_t Turn = 0u;
+            while (!Stopping.load(std::memory_order_relaxed))
+            {
+                epoll_event Ready{};
+                if (epoll_wait(Epoll, &Ready, 1, 200) <= 0) { continue; }
+                for (int Fd = accept4(Listener, nullptr, nullptr, SOCK_NONBLOCK); Fd >= 0; Fd = accept4(Listener, nullptr, nullptr, SOCK_NONBLOCK))
+                {
+                    int On = 1;
+                    setsockopt(Fd, IPPROTO_TCP, TCP_NODELAY, &On, sizeof(On));
+                    Connection* Co = new Connection{ Fd, {}, {}, 0u, 0u, EPOLLIN | EPOLLRDHUP, false };
+                    {
+                        std::lock_guard<std::mutex> Guard{ Lock };
+                        Co->Slot = Open.size();
+                        Open.push_back(Co);
+                    }
+                    epoll_event Add{};
+                    Add.events = Co->Watched;
+                    Add.data.ptr = Co;
+                    if (epoll_ctl(Loops[Turn++ % Loops.size()].Epoll, EPOLL_CTL_ADD, Fd, &Add) != 0)
+                    {
+                        Drop(*Co);
+                        continue;
+                    }
+                    Accepted.fetch_add(1u, std::memory_order_relaxed);
+                }
+            }
+            for (Loop& Lo : Loops) { Lo.Worker.join(); }
+            for (Loop& Lo : Loops) { close(Lo.Epoll); }
+            close(Epoll);
+            while (!Open.empty()) { Drop(*Open.back()); }
+        };
+        // Closes the connection and takes it out of Open by moving the last one into its Slot.
+        void Drop(Connection& Co) &
+        {
+            close(Co.Fd);
+            {
+                std::lock_guard<std::mutex> Guard{ Lock };
+                Open[Co.Slot] = Open.back();
+                Open[Co.Slot]->Slot = Co.Slot;
+                Open.pop_back();
+            }
+            delete &Co;
+        };
+        // Reads what has come for each ready connection, runs its complete lines and writes the answers, waiting
+        // for the connection to drain when it does not take them all. A connection whose peer has shut down its
+        // writing is read no more, and is closed once its answers are all written.
+        void Serve(int Epoll) &
+        {
+            epoll_event Ready[Events]{};
+            char Buffer[Chunk];
+            while (!Stopping.load(std::memory_order_relaxed))
+            {
+                int Count = epoll_wait(Epoll, Ready, Events, 200);
+                for (int i = 0; i < Count; ++i)
+                {
+                    Connection* Co = static_cast<Connection*>(Ready[i].data.ptr);
+                    bool Closed = (Ready[i].events & (EPOLLERR | EPOLLHUP)) != 0u;
+                    if (!Co->Ending && (Ready[i].events & (EPOLLIN | EPOLLRDHUP)) != 0u)
+                    {
+                        for (;;)
+                        {
+                            ssize_t Read = read(Co->Fd, Buffer, sizeof(Buffer));
+                            if (Read > 0)
+                            {
+                                Co->In.append(Buffer, static_cast<std::size_t>(Read));
+                                Execute(*Co);
+                                if (Co->Out.size() - Co->Sent > Backlog && !Flush(Epoll, *Co))
+                                {
+                                    Closed = true;
+                                    break;
+                                }
+                                if (Co->In.size() > Longest || Co->Out.size() - Co->Sent > Backlog)
+                                {
+                                    Closed = true;
+                                    break;
+                                }
+                            }
+                            else
+                            {
+                                if (Read == 0) { Co->Ending = true; }
+                                else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) { Closed = true; }
+                                break;
+                            }
+                        }
+                    }
+                    if (!Closed && !Flush(Epoll, *Co)) { Closed = true; }
+                    if (Co->Ending && Co->Out.empty()) { Closed = true; }
+                    if (Closed)
+                    {
+                        epoll_ctl(Epoll, EPOLL_CTL_DEL, Co->Fd, nullptr);
+                        Drop(*Co);
+                    }
+                }
+            }
+        };
+        // Runs the complete lines read so far, and keeps the rest for the next read.
+        void Execute(Connection& Co) &
+        {
+            std::size_t First = 0u;
+            for (std::size_t End = Co.In.find('\n'); End != std::string::npos; End = Co.In.find('\n', First))
+            {
+                Host.Execute(std::string_view{ Co.In }.substr(First, End - First), Co.Out);
+                First = End + 1u;
+            }
+            Co.In.erase(0, First);
+        };
+        // Writes what is left of the answers, and returns false when the connection has failed.
+        static bool Flush(int Epoll, Connection& Co)
+        {
+            while (Co.Sent < Co.Out.size())
+            {
+                ssize_t Written = write(Co.Fd, Co.Out.data() + Co.Sent, Co.Out.size() - Co.Sent);
+                if (Written > 0) { Co.Sent += static_cast<std::size_t>(Written); }
+                else if (Written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { break; }
+                else { return false; }
+            }
+            if (Co.Sent == Co.Out.size())
+            {
+                Co.Out.clear();
+                Co.Sent = 0u;
+            }
+            std::uint32_t Watched = (Co.Ending ? 0u : EPOLLIN | EPOLLRDHUP) | (Co.Out.empty() ? 0u : EPOLLOUT);
+            if (Watched != Co.Watched)
+            {
+                epoll_event Mod{};
+                Mod.events = Watched;
+                Mod.data.ptr = &Co;
+                epoll_ctl(Epoll, EPOLL_CTL_MOD, Co.Fd, &Mod);
+                Co.Watched = Watched;
+            }
+            return true;
+        };
+#pragma endregion
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Server::Main(argc, argv);
+};
@@ -0,0 +1,482 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Referee.h"
+namespace Gomoku
+{
+    // Searches for a forced win of the side to move by threats only, that is, by fours for the victory by
+    // continuous fours (Vcf), and by fours and threes for the victory by continuous threes (Vct). The defender
+    // answers a four at its five point only, and a three at every point where the attacker would make a four
+    // or where the defender makes a four of its own; any other answer is assumed to lose to the next four.
+    class Solver
+    {
+#pragma region helper-classes
+    public:
+        enum struct Mode : std::uint8_t
+        {
+            Vcf = 0u,
+            Vct = 1u,
+        };
+        struct Stats
+        {
+        public:
+            std::uint64_t Nodes;
+            std::uint64_t Hits;
+            std::chrono::nanoseconds Elapsed;
+            constexpr Stats()
+                : Nodes{ 0u }, Hits{ 0u }, Elapsed{ 0 }
+            {};
+            constexpr double NodesPerSecond() const &
+            {
+                return Elapsed.count() > 0 ? Nodes * 1e9 / Elapsed.count() : 0e0;
+            };
+        };
+    private:
+        struct Slot
+        {
+        public:
+            std::uint64_t Key;
+            std::uint8_t Depth;
+            std::uint8_t Move;
+            bool Proven;
+            constexpr Slot()
+                : Key{ 0u }, Depth{ 0u }, Move{ Byte }, Proven{ false }
+            {};
+        };
+        struct Shape
+        {
+        public:
+            bool Five;
+            bool Overline;
+            int Fours;
+            int Threes;
+            constexpr Shape()
+                : Five{ false }, Overline{ false }, Fours{ 0 }, Threes{ 0 }
+            {};
+        };
+        struct Threat
+        {
+        public:
+            std::uint8_t Po;
+            std::uint8_t Rank;
+        };
+#pragma endregion
+#pragma region constants
+    private:
+        static constexpr const int Steps[4][2]{ { 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 } };
+        // Indexed by the Matches of a line, the fives, the overlines, the fours and the threes of Black, and the
+        // fives, the fours and the threes of White, a Nibble each, so that the 4 lines of a point add up without
+        // a branch.
+        static const std::array<std::uint32_t, 256> Sums;
+#pragma endregion
+#pragma region fields
+    private:
+        std::vector<Slot> Slots;
+        std::size_t Mask;
+        LineBoard Bo;
+        std::uint32_t Stones[15];
+        std::uint8_t Around[15][15];
+        std::uint32_t Near[15];
+        // The Counter.Match of each line through each empty point as if Black put a Chess there, in the low
+        // Nibble, and as if White did, in the high one.
+        std::uint8_t Matches[256][4];
+        // The Matches of the points within 4 on the lines through each Chess put, which the Take restores.
+        std::uint8_t Saved[226][4][9];
+        int Ply;
+        Mode Mo;
+        bool Bk;
+        Stats St;
+        std::vector<Position> Line;
+        std::chrono::steady_clock::time_point Deadline;
+        bool Stopped;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit Solver(std::size_t Megabytes = 16u)
+            : Slots{}, Mask{ 0u }, Bo{}, Stones{}, Around{}, Near{}, Matches{}, Saved{}, Ply{ 0 }, Mo{ Mode::Vcf }, Bk{ true }, St{}, Line{}, Deadline{}, Stopped{ false }
+        {
+            std::size_t Count = 1u;
+            while (Count * 2u * sizeof(Slot) <= (Megabytes << 20)) { Count *= 2u; }
+            Slots.assign(Count, Slot{});
+            Mask = Count - 1u;
+            Line.reserve(225u);
+        };
+        const Stats& LastStats() const &
+        {
+            return St;
+        };
+        void Clear() &
+        {
+            std::fill(Slots.begin(), Slots.end(), Slot{});
+        };
+        // Returns whether the side to move wins within Depth moves of its own, and the shortest winning line
+        // found alternating from the attacker, which ends with the move after which the defender cannot stop a
+        // five. Where a three has several answers, the line follows the first of them. The search gives up as
+        // not won once Deadline has passed, keeping nothing in the table from the nodes it leaves unfinished.
+        bool Solve(const Board& Source, Mode Mo, int Depth, std::vector<Position>& Result,
+            std::chrono::steady_clock::time_point Deadline = std::chrono::steady_clock::time_point::max()) &
+        {
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            St = Stats{};
+            this->Deadline = Deadline;
+            Stopped = false;
+            Bo = LineBoard{ Source };
+            this->Mo = Mo;
+            Bk = Source.IsBlackTurn();
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                Stones[Y] = 0u;
+                Near[Y] = 0u;
+                for (int X = 0; X < 15; ++X) { Around[Y][X] = 0u; }
+            }
+            for (Board::ChessCRef Ch : Source)
+            {
+                if (Ch != Chess::None) { Mark(Ch.Pos(), 1); }
+            }
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                for (int X = 0; X < 15; ++X)
+                {
+                    for (int Or = 0; Or < 4; ++Or) { Classify(Position{ X, Y }, Or); }
+                }
+            }
+            Ply = 0;
+            Line.clear();
+            bool Won = false;
+            for (int d = 1; d <= std::min(Depth, 112) && !Won && !Stopped && !Source.IsPending() && !Source.IsEnded(); ++d) { Won = Attack(d); }
+            if (Stopped) { Line.clear(); }
+            Result.assign(Line.begin(), Line.end());
+            St.Elapsed = std::chrono::steady_clock::now() - Begin;
+            return Won;
+        };
+    private:
+        void Mark(Position Po, int Delta) &
+        {
+            int X = Po.X();
+            int Y = Po.Y();
+            if (Delta > 0) { Stones[Y] |= Bit << X; }
+            else { Stones[Y] &= ~(Bit << X); }
+            for (int j = std::max(Y - 2, 0), Ej = std::min(Y + 2, 14); j <= Ej; ++j)
+            {
+                for (int i = std::max(X - 2, 0), Ei = std::min(X + 2, 14); i <= Ei; ++i)
+                {
+                    Around[j][i] = static_cast<std::uint8_t>(Around[j][i] + Delta);
+                    if (Around[j][i] != 0u) { Near[j] |= Bit << i; }
+                    else { Near[j] &= ~(Bit << i); }
+                }
+            }
+        };
+        // Puts a Chess at Po and classifies again the line through Po of each point within 4 on its 4 lines,
+        // keeping their Matches for the Take.
+        void Put(Position Po, bool Black) &
+        {
+            Bo[Po] = Black ? Chess::Black : Chess::White;
+            Mark(Po, 1);
+            std::uint8_t (&Kept)[4][9] = Saved[Ply++];
+            for (int Or = 0; Or < 4; ++Or)
+            {
+                for (int d = -4; d <= 4; ++d)
+                {
+                    int X = Po.X() + Steps[Or][0] * d;
+                    int Y = Po.Y() + Steps[Or][1] * d;
+                    if (X < 0 || X > 14 || Y < 0 || Y > 14) { continue; }
+                    Position At{ X, Y };
+                    Kept[Or][d + 4] = Matches[static_cast<std::uint8_t>(At)][Or];
+                    Classify(At, Or);
+                }
+            }
+        };
+        void Take(Position Po) &
+        {
+            Bo[Po] = Chess::None;
+            Mark(Po, -1);
+            const std::uint8_t (&Kept)[4][9] = Saved[--Ply];
+            for (int Or = 0; Or < 4; ++Or)
+            {
+                for (int d = -4; d <= 4; ++d)
+                {
+                    int X = Po.X() + Steps[Or][0] * d;
+                    int Y = Po.Y() + Steps[Or][1] * d;
+                    if (X < 0 || X > 14 || Y < 0 || Y > 14) { continue; }
+                    Matches[static_cast<std::uint8_t>(Position{ X, Y })][Or] = Kept[Or][d + 4];
+                }
+            }
+        };
+        // Classifies the line through an empty Po as if either side put a Chess there, skipping it for a side
+        // with less than 2 other Chesses on it, which matches nothing.
+        void Classify(Position Po, int Or) &
+        {
+            std::uint8_t Code = 0u;
+            if (Bo[Po] == Chess::None)
+            {
+                std::uint32_t Li = Bo.GetLine(Po, static_cast<Orientation>(Or));
+                std::uint32_t Blacks = Li & ~(Li >> 1) & 0x15455u;
+                std::uint32_t Whites = (Li >> 1) & ~Li & 0x15455u;
+                if ((Blacks & (Blacks - 1u)) != 0u)
+                {
+                    std::uint32_t Mine = (Li & ~(Box << 8)) | (static_cast<std::uint32_t>(Chess::Black) << 8);
+                    Code |= static_cast<std::uint8_t>(Counter::Classify(Counter::MySide(Mine, true), true));
+                }
+                if ((Whites & (Whites - 1u)) != 0u)
+                {
+                    std::uint32_t Mine = (Li & ~(Box << 8)) | (static_cast<std::uint32_t>(Chess::White) << 8);
+                    Code |= static_cast<std::uint8_t>(static_cast<std::uint32_t>(Counter::Classify(Counter::MySide(Mine, false), true)) << 4);
+                }
+            }
+            Matches[static_cast<std::uint8_t>(Po)][Or] = Code;
+        };
+        // Sums the Matches of the 4 lines through an empty Po by the Sums, where an overline of White is a five.
+        void Examine(Position Po, Shape& Black, Shape& White) const &
+        {
+            const std::uint8_t (&Codes)[4] = Matches[static_cast<std::uint8_t>(Po)];
+            std::uint32_t Sum = Sums[Codes[0]] + Sums[Codes[1]] + Sums[Codes[2]] + Sums[Codes[3]];
+            Black.Five = (Sum & Nibble) != 0u;
+            Black.Overline = (Sum >> 4 & Nibble) != 0u;
+            Black.Fours = static_cast<int>(Sum >> 8 & Nibble);
+            Black.Threes = static_cast<int>(Sum >> 12 & Nibble);
+            White.Five = (Sum >> 16 & Nibble) != 0u;
+            White.Fours = static_cast<int>(Sum >> 20 & Nibble);
+            White.Threes = static_cast<int>(Sum >> 24 & Nibble);
+        };
+        // Screens the point by its Matches as the MoveGenerator.Allowed does, so that only a point of 2 threes
+        // or more and neither an overline nor 2 fours needs the LineReferee.
+        bool Legal(Position Po, bool Black) &
+        {
+            if (!Black) { return true; }
+            Shape Mine{};
+            Shape Theirs{};
+            Examine(Po, Mine, Theirs);
+            if (Mine.Overline || Mine.Fours >= 2) { return false; }
+            if (Mine.Threes < 2) { return true; }
+            LineReferee Rf{ Bo };
+            return Rf.Forbid(Po) == Forbidden::None;
+        };
+        std::uint64_t Key() const &
+        {
+            return Bo.Hash() ^ (Mo == Mode::Vct ? 0xA5A5A5A5A5A5A5A5ull : 0u);
+        };
+        bool Expired() &
+        {
+            if ((St.Nodes & 1023u) == 0u && std::chrono::steady_clock::now() >= Deadline) { Stopped = true; }
+            return Stopped;
+        };
+        bool Attack(int Depth) &
+        {
+            ++St.Nodes;
+            if (Expired()) { return false; }
+            std::uint64_t Ke = Key();
+            Slot& Sl = Slots[Ke & Mask];
+            std::uint8_t Hinted = Byte;
+            if (Sl.Key == Ke)
+            {
+                ++St.Hits;
+                if (!Sl.Proven && Sl.Depth >= Depth) { return false; }
+                if (Sl.Proven) { Hinted = Sl.Move; }
+            }
+            Threat Threats[225]{};
+            int Count = 0;
+            int Blocks = 0;
+            std::uint8_t Block = Byte;
+            for (int Y = 0; Y < 15; ++Y)
+            {
+                for (std::uint32_t Li = Near[Y] & ~Stones[Y]; Li != 0u; Li &= Li - 1u)
+                {
+                    Position Po{ std::countr_zero(Li), Y };
+                    Shape Black{};
+                    Shape White{};
+                    Examine(Po, Black, White);
+                    Shape& Mine = Bk ? Black : White;
+                    Shape& Theirs = Bk ? White : Black;
+                    if (Mine.Five && Legal(Po, Bk))
+                    {
+                        Line.push_back(Po);
+                        Keep(Ke, Depth, Po, true);
+                        return true;
+                    }
+                    if (Theirs.Five && Legal(Po, !Bk))
+                    {
+                        ++Blocks;
+                        Block = static_cast<std::uint8_t>(Po);
+                    }
+                    std::uint8_t Rank = Mine.Fours > 0 ? 2u : Mo == Mode::Vct && Mine.Threes > 0 ? 1u : 0u;
+                    if (static_cast<std::uint8_t>(Po) == Hinted) { Rank = 3u; }
+                    if (Rank > 0u) { Threats[Count++] = Threat{ static_cast<std::uint8_t>(Po), Rank }; }
+                }
+            }
+            if (Depth <= 0 || Blocks >= 2)
+            {
+                Keep(Ke, Depth, Position::Null, false);
+                return false;
+            }
+            std::sort(Threats, Threats + Count, [](const Threat& L, const Threat& R) { return L.Rank != R.Rank ? L.Rank > R.Rank : L.Po < R.Po; });
+            std::size_t Size = Line.size();
+            for (int i = 0; i < Count; ++i)
+            {
+                Position Po{ Threats[i].Po };
+                if (Blocks == 1 && Threats[i].Po != Block) { continue; }
+                if (!Legal(Po, Bk)) { continue; }
+                Put(Po, Bk);
+                Line.push_back(Po);
+                bool Won = Defend(Depth, Po);
+                Take(Po);
+                if (Stopped) { return false; }
+                if (Won)
+                {
+                    Keep(Ke, Depth, Po, true);
+                    return true;
+                }
+                Line.erase(Line.begin() + static_cast<std::ptrdiff_t>(Size), Line.end());
+            }
+            Keep(Ke, Depth, Position::Null, false);
+            return false;
+        };
+        // The attacker has just put Last. A five of the defender was blocked by the attacker already, so the
+        // fives of the attacker and the answers to a three are all on the 4 lines through Last, except for the
+        // fours of the defender, which may be anywhere.
+        bool Defend(int Depth, Position Last) &
+        {
+            ++St.Nodes;
+            if (Expired()) { return false; }
+            int Fives = 0;
+            std::uint8_t Five = Byte;
+            std::uint8_t Replies[225]{};
+            int Count = 0;
+            for (const int (&Step)[2] : Steps)
+            {
+                for (int k = -4; k <= 4; ++k)
+                {
+                    int X = Last.X() + Step[0] * k;
+                    int Y = Last.Y() + Step[1] * k;
+                    if (k == 0 || X < 0 || X > 14 || Y < 0 || Y > 14 || (Stones[Y] >> X & Bit) != 0u) { continue; }
+                    Position Po{ X, Y };
+                    Shape Black{};
+                    Shape White{};
+                    Examine(Po, Black, White);
+                    Shape& Mine = Bk ? Black : White;
+                    if (Mine.Five && Legal(Po, Bk))
+                    {
+                        ++Fives;
+                        Five = static_cast<std::uint8_t>(Po);
+                    }
+                    if (Mine.Fours > 0) { Replies[Count++] = static_cast<std::uint8_t>(Po); }
+                }
+            }
+            if (Fives >= 2) { return true; }
+            if (Fives == 1)
+            {
+                Replies[0] = Five;
+                Count = 1;
+            }
+            else if (Mo == Mode::Vcf || Count == 0) { return false; }
+            else
+            {
+                for (int Y = 0; Y < 15; ++Y)
+                {
+                    for (std::uint32_t Li = Near[Y] & ~Stones[Y]; Li != 0u; Li &= Li - 1u)
+                    {
+                        Position Po{ std::countr_zero(Li), Y };
+                        Shape Black{};
+                        Shape White{};
+                        Examine(Po, Black, White);
+                        if ((Bk ? White : Black).Fours > 0 && std::find(Replies, Replies + Count, static_cast<std::uint8_t>(Po)) == Replies + Count)
+                        {
+                            Replies[Count++] = static_cast<std::uint8_t>(Po);
+                        }
+                    }
+                }
+            }
+            std::size_t Size = Line.size();
+            std::size_t End = Size;
+            for (int i = 0; i < Count; ++i)
+            {
+                Position Po{ Replies[i] };
+                if (!Legal(Po, !Bk))
+                {
+                    if (Fives == 1) { return true; }
+                    continue;
+                }
+                Put(Po, !Bk);
+                Line.push_back(Po);
+                bool Won = Attack(Depth - 1);
+                Take(Po);
+                if (Stopped) { return false; }
+                if (!Won)
+                {
+                    Line.erase(Line.begin() + static_cast<std::ptrdiff_t>(Size), Line.end());
+                    return false;
+                }
+                if (End == Size) { End = Line.size(); }
+                else { Line.erase(Line.begin() + static_cast<std::ptrdiff_t>(End), Line.end()); }
+            }
+            return true;
+        };
+    public:
+        static constexpr std::array<std::uint32_t, 256> Tabulate()
+        {
+            std::array<std::uint32_t, 256> Result{};
+            for (std::uint32_t Code = 0u; Code < 256u; ++Code)
+            {
+                Counter::Match Black = static_cast<Counter::Match>(Code & Nibble);
+                Counter::Match White = static_cast<Counter::Match>(Code >> 4);
+                std::uint32_t Sum = 0u;
+                if (Black == Counter::Match::T5) { Sum += 1u; }
+                else if (Black == Counter::Match::T6) { Sum += 1u << 4; }
+                else if (Black == Counter::Match::D4) { Sum += 2u << 8; }
+                else if (Black == Counter::Match::T4) { Sum += 1u << 8; }
+                else if (Black == Counter::Match::T3) { Sum += 1u << 12; }
+                if (White == Counter::Match::T6 || White == Counter::Match::T5) { Sum += 1u << 16; }
+                else if (White == Counter::Match::D4) { Sum += 2u << 20; }
+                else if (White == Counter::Match::T4) { Sum += 1u << 20; }
+                else if (White == Counter::Match::T3) { Sum += 1u << 24; }
+                Result[Code] = Sum;
+            }
+            return Result;
+        };
+    private:
+        void Keep(std::uint64_t Ke, int Depth, Position Po, bool Proven) &
+        {
+            Slot& Sl = Slots[Ke & Mask];
+            Sl.Key = Ke;
+            Sl.Depth = static_cast<std::uint8_t>(std::max(Depth, 0));
+            Sl.Move = static_cast<std::uint8_t>(Po);
+            Sl.Proven = Proven;
+        };
+#pragma endregion
+    };
+#pragma region global-initializes
+    inline constexpr const std::array<std::uint32_t, 256> Solver::Sums = Solver::Tabulate();
+#pragma endregion
+}
@@ -0,0 +1,206 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "EndgameTable.h"
+#include "Engine.h"
+#include "LazySmp.h"
+#include "Mcts.h"
+#include "Notation.h"
+#include "OpeningBook.h"
+#include "Solver.h"
+namespace Gomoku
+{
+    class Think
+    {
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            long Budget = 1000;
+            long Megabytes = 64;
+            int Vcf = 12;
+            int Vct = 0;
+            unsigned Threads = 1u;
+            int Scaling = 0;
+            bool Carlo = false;
+            const char* Book = nullptr;
+            const char* Endgame = nullptr;
+            std::string Record{};
+            for (int i = 1; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--ms") == 0 && i + 1 < argc) { Budget = std::atol(argv[++i]); }
+                else if (std::strcmp(argv[i], "--hash") == 0 && i + 1 < argc) { Megabytes = std::atol(argv[++i]); }
+                else if (std::strcmp(argv[i], "--vcf") == 0 && i + 1 < argc) { Vcf = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--vct") == 0 && i + 1 < argc) { Vct = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { Threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+                else if (std::strcmp(argv[i], "--scaling") == 0 && i + 1 < argc) { Scaling = std::atoi(argv[++i]); }
+                else if (std::strcmp(argv[i], "--mcts") == 0) { Carlo = true; }
+                else if (std::strcmp(argv[i], "--book") == 0 && i + 1 < argc) { Book = argv[++i]; }
+                else if (std::strcmp(argv[i], "--endgame") == 0 && i + 1 < argc) { Endgame = argv[++i]; }
+                else if (argv[i][0] != '-')
+                {
+                    Record += argv[i];
+                    Record += ' ';
+                }
+                else
+                {
+                    std::fprintf(stderr, "usage: %s [--ms N] [--hash MB] [--vcf N] [--vct N] [--threads N] [--scaling DEPTH] [--mcts] [--book file] [--endgame file] [moves...]\n", argv[0]);
+                    return 1;
+                }
+            }
+            if (Threads != 1u && Megabytes <= 0 && !Carlo && Scaling <= 0)
+            {
+                std::fprintf(stderr, "--threads needs a table for the threads to share, which --hash 0 leaves out\n");
+                return 1;
+            }
+            if (argc == 1 || (Record.empty() && !std::cin.eof())) { std::getline(std::cin, Record); }
+            std::vector<Position> Moves{};
+            if (!Notation::ParseGame(Record, Moves))
+            {
+                std::fprintf(stderr, "cannot parse the record after %zu moves\n", Moves.size());
+                return 1;
+            }
+            Board Bo{};
+            Referee Rf{ Bo };
+            for (Position Po : Moves)
+            {
+                if (!Bo.CanPutChess(Po) || Rf.PutChess(Po).Re != Result::None)
+                {
+                    std::fprintf(stderr, "the record is illegal or already decided at %s\n", Notation::Format(Po).c_str());
+                    return 1;
+                }
+            }
+            if (Scaling > 0) { return Scale(Bo, Scaling, Megabytes > 0 ? Megabytes : 64); }
+            if (Book != nullptr)
+            {
+                OpeningBook Ob{ Book };
+                OpeningBook::Entry En{};
+                Position Po = Ob.Probe(Bo, En);
+                if (Po != Position::Null)
+                {
+                    std::printf("%s\n", Notation::Format(Po).c_str());
+                    std::fprintf(stderr, "book, games %u, score %.3f\n", En.Games, En.Score());
+                    return 0;
+                }
+            }
+            std::unique_ptr<EndgameTable> Et{};
+            if (Endgame != nullptr)
+            {
+                Et = std::make_unique<EndgameTable>(Endgame);
+                Position Po = Position::Null;
+                int Length = 0;
+                if (Et->Probe(Bo, Po, Length) == ProofSearch::Outcome::Win && Po != Position::Null)
+                {
+                    std::printf("%s\n", Notation::Format(Po).c_str());
+                    std::fprintf(stderr, "endgame, win in %d moves\n", Length);
+                    return 0;
+                }
+            }
+            Solver Sv{};
+            std::vector<Position> Line{};
+            for (Solver::Mode Mo : { Solver::Mode::Vcf, Solver::Mode::Vct })
+            {
+                int Depth = Mo == Solver::Mode::Vcf ? Vcf : Vct;
+                if (Depth <= 0 || !Sv.Solve(Bo, Mo, Depth, Line) || Line.empty()) { continue; }
+                const Solver::Stats& St = Sv.LastStats();
+                std::printf("%s\n", Notation::Format(Line[0]).c_str());
+                std::fprintf(stderr, "%s", Mo == Solver::Mode::Vcf ? "vcf" : "vct");
+                for (Position Po : Line) { std::fprintf(stderr, " %s", Notation::Format(Po).c_str()); }
+                std::fprintf(stderr, ", nodes %llu, %.3f s, %.0f nodes/s\n", static_cast<unsigned long long>(St.Nodes),
+                    St.Elapsed.count() / 1e9, St.NodesPerSecond());
+                return 0;
+            }
+            if (Carlo)
+            {
+                Mcts Mc{ Threads, Megabytes > 0 ? static_cast<std::size_t>(Megabytes) : 64u };
+                Position Best = Mc.BestMove(Bo, std::chrono::milliseconds{ Budget });
+                const Mcts::Stats& St = Mc.LastStats();
+                std::printf("%s\n", Notation::Format(Best).c_str());
+                std::fprintf(stderr, "rate %.3f, visits %u, playouts %llu, nodes %llu, depth %d, %.3f s, %.0f playouts/s\n",
+                    St.Rate, St.Visits, static_cast<unsigned long long>(St.Playouts), static_cast<unsigned long long>(St.Nodes), St.Depth,
+                    St.Elapsed.count() / 1e9, St.PlayoutsPerSecond());
+                return 0;
+            }
+            std::unique_ptr<TranspositionTable> Tt{};
+            if (Megabytes > 0) { Tt = std::make_unique<TranspositionTable>(static_cast<std::size_t>(Megabytes)); }
+            Engine En{ Tt.get() };
+            En.Consult(Et.get());
+            Position Best = Position::Null;
+            Engine::Stats St{};
+            if (Threads != 1u && Tt != nullptr)
+            {
+                LazySmp Smp{ *Tt, Threads };
+                Smp.Consult(Et.get());
+                Best = Smp.BestMove(Bo, std::chrono::milliseconds{ Budget });
+                St = Smp.LastStats();
+            }
+            else
+            {
+                Best = En.BestMove(Bo, std::chrono::milliseconds{ Budget });
+                St = En.LastStats();
+            }
+            double Seconds = St.Elapsed.count() / 1e9;
+            std::printf("%s\n", Notation::Format(Best).c_str());
+            std::fprintf(stderr, "score %d, depth %d, nodes %llu, hits %llu, %.3f s, %.0f nodes/s, %.2f depth/s\n",
+                St.Score, St.Depth, static_cast<unsigned long long>(St.Nodes), static_cast<unsigned long long>(St.Hits), Seconds, St.NodesPerSecond(), Seconds > 0 ? St.Depth / Seconds : 0e0);
+            return 0;
+        };
+    private:
+        // Searches to Depth with 1, 2, 4 and so on up to 32 threads, each from an empty table, and reports the
+        // time to reach Depth and the nodes per second against a single thread.
+        static int Scale(const Board& Bo, int Depth, long Megabytes)
+        {
+            TranspositionTable Tt{ static_cast<std::size_t>(Megabytes) };
+            double Single = 0e0;
+            std::printf("threads\tdepth\tmove\tseconds\tnodes\tnodes/s\tspeedup\n");
+            for (unsigned Threads = 1u; Threads <= 32u; Threads *= 2u)
+            {
+                Tt.Clear();
+                LazySmp Smp{ Tt, Threads };
+                Position Best = Smp.BestMove(Bo, std::chrono::hours{ 1 }, Depth);
+                const Engine::Stats& St = Smp.LastStats();
+                double Seconds = St.Elapsed.count() / 1e9;
+                if (Threads == 1u) { Single = Seconds; }
+                std::printf("%u\t%d\t%s\t%.3f\t%llu\t%.0f\t%.2f\n", Threads, St.Depth, Notation::Format(Best).c_str(), Seconds,
+                    static_cast<unsigned long long>(St.Nodes), St.NodesPerSecond(), Seconds > 0 ? Single / Seconds : 0e0);
+            }
+            return 0;
+        };
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Think::Main(argc, argv);
+};
@@ -0,0 +1,259 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Agents.h"
+#include "Notation.h"
+#include "Scheduler.h"
+#include "TranspositionTable.h"
+namespace Gomoku
+{
+    class Tournament
+    {
+#pragma region helper-classes
+    private:
+        struct Game
+        {
+        public:
+            Result Re;
+            Forbidden Fo;
+            bool FirstIsBlack;
+            bool Faulty;
+            int Moves[2];
+            std::chrono::nanoseconds Spent[2];
+            constexpr Game()
+                : Re{ Result::None }, Fo{ Forbidden::None }, FirstIsBlack{ true }, Faulty{ false }, Moves{}, Spent{}
+            {};
+        };
+#pragma endregion
+#pragma region constructors-and-methods
+    private:
+        // The 26 openings of 3 Chesses, that is, White next to the center either directly or diagonally and
+        // Black anywhere within 2 boxes of the center, counted once up to the 8 transforms of the square.
+        static std::vector<std::vector<Position>> Openings()
+        {
+            std::vector<std::vector<Position>> Result{};
+            std::vector<std::uint64_t> Seen{};
+            for (Position Second : { Position{ 7, 6 }, Position{ 8, 6 } })
+            {
+                for (int Y = 5; Y <= 9; ++Y)
+                {
+                    for (int X = 5; X <= 9; ++X)
+                    {
+                        Board Bo{};
+                        Bo[Position{ 7, 7 }] = Chess::Black;
+                        Bo[Second] = Chess::White;
+                        if (Bo[Position{ X, Y }] != Chess::None) { continue; }
+                        Bo[Position{ X, Y }] = Chess::Black;
+                        int Tr = 0;
+                        std::uint64_t Key = Symmetry::Canonical(Bo, Tr);
+                        if (std::find(Seen.begin(), Seen.end(), Key) != Seen.end()) { continue; }
+                        Seen.push_back(Key);
+                        Result.push_back(std::vector<Position>{ Position{ 7, 7 }, Second, Position{ X, Y } });
+                    }
+                }
+            }
+            return Result;
+        };
+        static Game Play(const std::vector<Position>& Opening, Agent& First, Agent& Second, bool FirstIsBlack)
+        {
+            Game Ga{};
+            Ga.FirstIsBlack = FirstIsBlack;
+            Board Bo{};
+            Referee Rf{ Bo };
+            for (Position Po : Opening)
+            {
+                if (!Bo.CanPutChess(Po))
+                {
+                    Ga.Faulty = true;
+                    return Ga;
+                }
+                Verdict Ve = Rf.PutChess(Po);
+                if (Ve.Re != Result::None)
+                {
+                    Ga.Faulty = true;
+                    return Ga;
+                }
+            }
+            while (Ga.Re == Result::None)
+            {
+                bool Bk = Bo.IsBlackTurn();
+                int Side = Bk == FirstIsBlack ? 0 : 1;
+                Agent& Ag = Side == 0 ? First : Second;
+                std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+                Position Po = Ag.Move(Bo);
+                Ga.Spent[Side] += std::chrono::steady_clock::now() - Begin;
+                ++Ga.Moves[Side];
+                if (!Bo.CanPutChess(Po))
+                {
+                    Ga.Re = Bk ? Result::Lost : Result::Won;
+                    break;
+                }
+                Verdict Ve = Rf.PutChess(Po);
+                Ga.Re = Ve.Re;
+                Ga.Fo = Ve.Fo;
+            }
+            return Ga;
+        };
+        static double Elo(double Score)
+        {
+            if (Score <= 0e0) { return -HUGE_VAL; }
+            if (Score >= 1e0) { return HUGE_VAL; }
+            return -400e0 * std::log10(1e0 / Score - 1e0);
+        };
+    public:
+        static int Main(int argc, char* argv[])
+        {
+            std::string First = "greedy";
+            std::string Second = "random";
+            long Games = 52;
+            unsigned Threads = 0u;
+            std::uint64_t Seed = 1u;
+            const char* Path = nullptr;
+            for (int i = 1; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--a") == 0 && i + 1 < argc) { First = argv[++i]; }
+                else if (std::strcmp(argv[i], "--b") == 0 && i + 1 < argc) { Second = argv[++i]; }
+                else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) { Games = std::atol(argv[++i]); }
+                else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { Threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+                else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) { Seed = std::strtoull(argv[++i], nullptr, 10); }
+                else if (std::strcmp(argv[i], "--openings") == 0 && i + 1 < argc) { Path = argv[++i]; }
+                else
+                {
+                    std::fprintf(stderr, "usage: %s [--a SPEC] [--b SPEC] [--games N] [--threads N] [--seed N] [--openings file]\n", argv[0]);
+                    std::fprintf(stderr, "SPEC is random, greedy, engine:MS or mcts:MS\n");
+                    return 1;
+                }
+            }
+            if (Agent::Make(First, 0u) == nullptr || Agent::Make(Second, 0u) == nullptr)
+            {
+                std::fprintf(stderr, "unknown player %s or %s\n", First.c_str(), Second.c_str());
+                return 1;
+            }
+            std::vector<std::vector<Position>> Book{};
+            if (Path != nullptr)
+            {
+                std::ifstream File{ Path };
+                if (!File)
+                {
+                    std::fprintf(stderr, "cannot open %s\n", Path);
+                    return 1;
+                }
+                std::string Line{};
+                while (std::getline(File, Line))
+                {
+                    std::vector<Position> Moves{};
+                    if (Notation::ParseGame(Line, Moves)) { Book.push_back(std::move(Moves)); }
+                }
+            }
+            else { Book = Openings(); }
+            if (Book.empty() || Games <= 0)
+            {
+                std::fprintf(stderr, "nothing to play\n");
+                return 1;
+            }
+            // Game i plays opening i / 2 with the first player taking Black on even i, so each opening is played
+            // from both sides.
+            std::vector<Game> Played(static_cast<std::size_t>(Games));
+            Scheduler Sc{ Threads };
+            std::chrono::steady_clock::time_point Begin = std::chrono::steady_clock::now();
+            Sc.ParallelFor(Played.size(), 1u, [&](std::size_t i, unsigned)
+            {
+                std::unique_ptr<Agent> A = Agent::Make(First, Seed * 0x9E3779B97F4A7C15ull + i * 2u);
+                std::unique_ptr<Agent> B = Agent::Make(Second, Seed * 0x9E3779B97F4A7C15ull + i * 2u + 1u);
+                Played[i] = Play(Book[(i / 2u) % Book.size()], *A, *B, i % 2u == 0u);
+            });
+            double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Begin).count();
+            long Wins = 0;
+            long Losses = 0;
+            long Draws = 0;
+            long Faulty = 0;
+            long Forbids[2]{};
+            long Moves[2]{};
+            std::chrono::nanoseconds Spent[2]{};
+            for (const Game& Ga : Played)
+            {
+                if (Ga.Faulty)
+                {
+                    ++Faulty;
+                    continue;
+                }
+                for (int Side = 0; Side < 2; ++Side)
+                {
+                    Moves[Side] += Ga.Moves[Side];
+                    Spent[Side] += Ga.Spent[Side];
+                }
+                if (Ga.Re == Result::Tied) { ++Draws; }
+                else if ((Ga.Re == Result::Won) == Ga.FirstIsBlack) { ++Wins; }
+                else { ++Losses; }
+                if (Ga.Fo != Forbidden::None) { ++Forbids[Ga.FirstIsBlack ? 0 : 1]; }
+            }
+            long Count = Wins + Losses + Draws;
+            if (Count == 0)
+            {
+                std::fprintf(stderr, "every opening is illegal\n");
+                return 1;
+            }
+            double Score = (Wins + Draws * 5e-1) / Count;
+            // The Wilson interval over the variance of the score with draws counted half, which stays inside 0 and
+            // 1 even when every game is won or lost, so that its bounds are finite.
+            double Variance = (Wins + Draws * 25e-2) / Count - Score * Score;
+            double Z2 = 196e-2 * 196e-2;
+            double Shrink = 1e0 + Z2 / Count;
+            double Centre = (Score + Z2 / (2e0 * Count)) / Shrink;
+            double Margin = 196e-2 * std::sqrt(std::max(Variance, 0e0) / Count + Z2 / (4e0 * Count * Count)) / Shrink;
+            std::printf("%s vs %s: games %ld, wins %ld, losses %ld, draws %ld, score %.1f%%\n",
+                First.c_str(), Second.c_str(), Count, Wins, Losses, Draws, Score * 100e0);
+            std::printf("elo %+.1f, 95%% interval [%+.1f, %+.1f]\n", Elo(Score), Elo(Centre - Margin), Elo(Centre + Margin));
+            const std::string* Names[2]{ &First, &Second };
+            for (int Side = 0; Side < 2; ++Side)
+            {
+                std::printf("%s: %ld moves, %.3f ms/move, %ld forbidden losses\n", Names[Side]->c_str(), Moves[Side],
+                    Moves[Side] > 0 ? Spent[Side].count() / 1e6 / Moves[Side] : 0e0, Forbids[Side]);
+            }
+            std::fprintf(stderr, "openings %zu, threads %u, %.3f s, %.1f games/s\n", Book.size(), Sc.Threads(), Seconds, Count / Seconds);
+            if (Faulty > 0) { std::fprintf(stderr, "%ld games skipped for an illegal opening\n", Faulty); }
+            return 0;
+        };
+#pragma endregion
+    };
+}
+int main(int argc, char* argv[])
+{
+    return Gomoku::Tournament::Main(argc, argv);
+};
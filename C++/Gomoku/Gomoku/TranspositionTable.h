@@ -0,0 +1,216 @@
+#pragma region license
+/*
+ *   Gomoku
+ *
+ *   A game when you are in the first role, Black Chesses are Forbidden to
+ *   Win from three-three, four-four, and six or more in a row. In every
+ *   single Suspected Survive Three row, we shall consider any reference
+ *   point Forbidden by any subsequent with three-three, four-four, five in a
+ *   row, or six or more in a row.
+ *
+ *   Copyright (C) 2022  Edmond Chow
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published
+ *   by the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Affero General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ *   If you have any inquiry, feel free to contact <edmond-chow@outlook.com>.
+ */
+#pragma endregion
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "Referee.h"
+namespace Gomoku
+{
+    struct Symmetry
+    {
+    public:
+        // Transform bit 2 transposes first, then bit 0 mirrors X and bit 1 mirrors Y.
+        static constexpr Position Apply(Position Po, int Tr)
+        {
+            if (Po == Position::Null) { return Po; }
+            int X = Po.X();
+            int Y = Po.Y();
+            if ((Tr & 4) != 0) { std::swap(X, Y); }
+            if ((Tr & 1) != 0) { X = 14 - X; }
+            if ((Tr & 2) != 0) { Y = 14 - Y; }
+            return Position{ X, Y };
+        };
+        // The Board of Bo under the transform Tr, in the same round.
+        static constexpr Board Apply(const Board& Bo, int Tr)
+        {
+            Board Result{};
+            for (Board::ChessCRef Ch : Bo)
+            {
+                if (Ch != Chess::None) { Result[Apply(Ch.Pos(), Tr)] = Ch; }
+            }
+            for (int i = 0; i < Bo.Rounds(); ++i) { ++Result; }
+            return Result;
+        };
+        static constexpr int Inverse(int Tr)
+        {
+            if ((Tr & 4) == 0) { return Tr; }
+            return 4 | ((Tr & 1) << 1) | ((Tr & 2) >> 1);
+        };
+        static constexpr std::uint64_t Hash(const Board& Bo, int Tr)
+        {
+            if (Tr == 0) { return Bo.Hash(); }
+            std::uint64_t Result = 0u;
+            for (Board::ChessCRef Ch : Bo)
+            {
+                if (Ch == Chess::None) { continue; }
+                Result ^= Zobrist::Key(Apply(Ch.Pos(), Tr), Ch);
+            }
+            return Result;
+        };
+        static constexpr std::uint64_t Canonical(const Board& Bo, int& Tr)
+        {
+            std::uint64_t Hashes[8]{ Bo.Hash() };
+            for (Board::ChessCRef Ch : Bo)
+            {
+                if (Ch == Chess::None) { continue; }
+                for (int i = 1; i < 8; ++i) { Hashes[i] ^= Zobrist::Key(Apply(Ch.Pos(), i), Ch); }
+            }
+            Tr = 0;
+            for (int i = 1; i < 8; ++i)
+            {
+                if (Hashes[i] < Hashes[Tr]) { Tr = i; }
+            }
+            return Hashes[Tr];
+        };
+    };
+    class TranspositionTable
+    {
+#pragma region helper-classes
+    public:
+        enum struct Bound : std::uint8_t
+        {
+            None = 0u,
+            Exact = 1u,
+            Lower = 2u,
+            Upper = 3u,
+        };
+        struct Entry
+        {
+        public:
+            Position Move;
+            int Depth;
+            Bound Bo;
+            int Score;
+            constexpr Entry()
+                : Move{ Position::Null }, Depth{ 0 }, Bo{ Bound::None }, Score{ 0 }
+            {};
+            constexpr Entry(Position Move, int Depth, Bound Bo, int Score)
+                : Move{ Move }, Depth{ Depth }, Bo{ Bo }, Score{ Score }
+            {};
+        };
+    private:
+        // Check holds Key ^ Data, so a torn pair of stores from two threads fails verification instead of
+        // being read back as a wrong entry.
+        struct Slot
+        {
+        public:
+            std::atomic<std::uint64_t> Check;
+            std::atomic<std::uint64_t> Data;
+        };
+        static constexpr std::uint64_t Pack(const Entry& En, std::uint8_t Generation)
+        {
+            return static_cast<std::uint64_t>(En.Move)
+                | static_cast<std::uint64_t>(En.Depth & Byte) << 8
+                | static_cast<std::uint64_t>(En.Bo) << 16
+                | static_cast<std::uint64_t>(Generation) << 24
+                | static_cast<std::uint64_t>(static_cast<std::uint32_t>(En.Score)) << 32;
+        };
+        static constexpr Entry Unpack(std::uint64_t Data)
+        {
+            return Entry{ Position{ static_cast<std::uint8_t>(Data & Byte) }, static_cast<int>(Data >> 8 & Byte),
+                static_cast<Bound>(Data >> 16 & Box), static_cast<int>(static_cast<std::uint32_t>(Data >> 32)) };
+        };
+#pragma endregion
+#pragma region fields
+    private:
+        std::unique_ptr<Slot[]> Slots;
+        std::size_t Mask;
+        std::uint8_t Generation;
+#pragma endregion
+#pragma region constructors-and-methods
+    public:
+        explicit TranspositionTable(std::size_t Megabytes)
+            : Slots{}, Mask{ 0u }, Generation{ 0u }
+        {
+            std::size_t Count = 1u;
+            while (Count * 2u * sizeof(Slot) <= (Megabytes << 20)) { Count *= 2u; }
+            Slots = std::make_unique<Slot[]>(Count);
+            Mask = Count - 1u;
+            Clear();
+        };
+        TranspositionTable(const TranspositionTable&) = delete;
+        TranspositionTable& operator=(const TranspositionTable&) = delete;
+        std::size_t Size() const &
+        {
+            return Mask + 1u;
+        };
+        void Clear() &
+        {
+            for (std::size_t i = 0; i <= Mask; ++i)
+            {
+                Slots[i].Check.store(0u, std::memory_order_relaxed);
+                Slots[i].Data.store(0u, std::memory_order_relaxed);
+            }
+            Generation = 0u;
+        };
+        void NewSearch() &
+        {
+            ++Generation;
+        };
+        bool Probe(std::uint64_t Key, Entry& En) const &
+        {
+            const Slot& Sl = Slots[Key & Mask];
+            std::uint64_t Data = Sl.Data.load(std::memory_order_relaxed);
+            std::uint64_t Check = Sl.Check.load(std::memory_order_relaxed);
+            if ((Check ^ Data) != Key || (Data >> 16 & Box) == static_cast<std::uint64_t>(Bound::None)) { return false; }
+            En = Unpack(Data);
+            return true;
+        };
+        void Store(std::uint64_t Key, const Entry& En) &
+        {
+            Slot& Sl = Slots[Key & Mask];
+            std::uint64_t Old = Sl.Data.load(std::memory_order_relaxed);
+            bool Same = (Sl.Check.load(std::memory_order_relaxed) ^ Old) == Key;
+            bool Stale = (Old >> 24 & Byte) != Generation;
+            if (!Same && !Stale && En.Depth < static_cast<int>(Old >> 8 & Byte)) { return; }
+            Entry Kept = En;
+            if (Same && Kept.Move == Position::Null) { Kept.Move = Unpack(Old).Move; }
+            std::uint64_t Data = Pack(Kept, Generation);
+            Sl.Check.store(Key ^ Data, std::memory_order_relaxed);
+            Sl.Data.store(Data, std::memory_order_relaxed);
+        };
+        bool ProbeSymmetric(const Board& Bo, Entry& En) const &
+        {
+            int Tr = 0;
+            if (!Probe(Symmetry::Canonical(Bo, Tr), En)) { return false; }
+            En.Move = Symmetry::Apply(En.Move, Symmetry::Inverse(Tr));
+            return true;
+        };
+        void StoreSymmetric(const Board& Bo, const Entry& En) &
+        {
+            int Tr = 0;
+            std::uint64_t Key = Symmetry::Canonical(Bo, Tr);
+            Store(Key, Entry{ Symmetry::Apply(En.Move, Tr), En.Depth, En.Bo, En.Score });
+        };
+#pragma endregion
+    };
+}